@@ -0,0 +1,42 @@
+#ifndef DATASET_MANAGER_HPP
+#define DATASET_MANAGER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class Trie;
+class TernarySearchTree;
+
+// Loads and normalizes a word list (one word per line, lowercased, whitespace stripped)
+class DatasetManager {
+private:
+    std::vector<std::string> words;
+    std::string filename;
+
+public:
+    DatasetManager(const std::string& file);
+
+    bool loadDataset();
+
+    // One pass over the file: a reader stage parses chunks of words into bounded
+    // lock-free queues while one thread per structure inserts them. Either
+    // structure may be null. Words end up in getWords() as with loadDataset()
+    bool loadPipelined(Trie* trie, TernarySearchTree* tst, std::size_t chunkSize = 4096);
+
+    const std::string& getFilename() const;
+
+    const std::vector<std::string>& getWords() const;
+
+    // Sorted, duplicate-free copy, as required by the DAWG builder
+    static std::vector<std::string> sortUnique(std::vector<std::string> list);
+    std::vector<std::string> getSortedWords() const;
+
+    std::vector<std::string> getSample(int n) const;
+
+private:
+    // Strip whitespace and lowercase; returns false if nothing is left
+    static bool normalize(std::string& word);
+};
+
+#endif
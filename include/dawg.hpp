@@ -0,0 +1,86 @@
+#ifndef DAWG_HPP
+#define DAWG_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// minimal acyclic automaton (dawg) built incrementally from sorted words
+// (daciuk et al.), so common suffixes like "-ing" or "-ness" are stored once.
+// once finished it is read only and lives in two flat arrays
+class Dawg {
+public:
+    Dawg();
+
+    // add the next word; words must come in strictly increasing order,
+    // out of order or duplicate words are rejected and return false
+    bool insert(const std::string& word);
+
+    // minimize the last path and freeze; call before querying
+    void finish();
+
+    // convenience: insert every word of a sorted list then finish
+    void build(const std::vector<std::string>& sorted_words);
+
+    // check if a word exists in the dawg
+    bool contains(const std::string& word) const;
+
+    // get up to max_results words that start with prefix, in lexicographic order
+    std::vector<std::string> autocomplete(const std::string& prefix, std::size_t max_results = 10) const;
+
+    // how many words start with prefix, read off the prefix state in o(|prefix|).
+    // an empty prefix counts (and select indexes) every word
+    std::size_t countPrefix(const std::string& prefix) const;
+
+    // index-th completion of prefix in lexicographic order, empty if out of range
+    std::string select(const std::string& prefix, std::size_t index) const;
+
+    std::size_t nodeCount() const; // states after minimization
+    std::size_t edgeCount() const;
+    std::size_t wordCount() const;
+    bool empty() const;
+
+    // below methods mirror the interface expected by main
+    bool search(const std::string& word) const; // alias for contains
+    std::vector<std::string> autoComplete(const std::string& prefix) const; // default sized autocomplete
+    std::size_t getMemoryUsage() const; // bytes used by the frozen arrays
+
+private:
+    struct Edge {
+        char label;
+        std::uint32_t target;
+    };
+
+    struct State {
+        std::uint32_t first_edge;
+        std::uint32_t word_count; // words reachable from here, same for every merged copy
+        std::uint8_t edge_count;
+        bool isEnd;
+    };
+
+    // a state on the path of the last inserted word, not yet checked against the register
+    struct PendingState {
+        bool isEnd = false;
+        std::vector<Edge> edges; // last edge's target is the next pending state until it is registered
+    };
+
+    std::vector<State> states;
+    std::vector<Edge> edges;
+    std::uint32_t root;
+    bool finished;
+
+    // build time only
+    std::vector<PendingState> pending;
+    std::string previous;
+    std::unordered_map<std::string, std::uint32_t> registry;
+
+    void minimize(std::size_t down_to);
+    std::uint32_t registerState(const PendingState& state);
+
+    const State* findPrefixState(const std::string& prefix) const;
+    void collect(const State& state, std::string& current, std::vector<std::string>& out, std::size_t max_results) const;
+};
+
+#endif // DAWG_HPP
@@ -0,0 +1,81 @@
+#ifndef LOUDS_HPP
+#define LOUDS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+class Trie;
+
+// read-only succinct encoding of a built trie (level-order unary degree sequence).
+// nodes are numbered in bfs order; node k's children are a 1 bit each in the
+// block after the k-th 0, and they get consecutive ids. so navigation needs only
+// select0 on the louds bits plus a label per node and one terminal bit per node
+class LoudsTrie {
+public:
+    LoudsTrie();
+
+    // encode an existing trie, replacing whatever was here
+    void build(const Trie& trie);
+
+    // check if a word exists
+    bool contains(const std::string& word) const;
+
+    // get up to max_results words that start with prefix, in lexicographic order
+    std::vector<std::string> autocomplete(const std::string& prefix, std::size_t max_results = 10) const;
+
+    // binary dump of the bit vectors and labels; select samples are rebuilt on load
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    std::size_t nodeCount() const;
+    bool empty() const;
+
+    // structural bits per node (louds + terminal + their indexes), labels excluded
+    double bitsPerNode() const;
+
+    // below methods mirror the interface expected by main
+    bool search(const std::string& word) const; // alias for contains
+    std::vector<std::string> autoComplete(const std::string& prefix) const; // default sized autocomplete
+    std::size_t getMemoryUsage() const; // bytes for bits, indexes and labels
+
+private:
+    // plain bit vector with select0 samples (position of every 512th zero).
+    // no rank directory: a child's id falls out of select0 arithmetic
+    class BitVector {
+    public:
+        void clear();
+        void push_back(bool bit);
+        void buildIndex();
+
+        bool get(std::size_t pos) const;
+        std::size_t select0(std::size_t k) const; // position of the k-th zero, 0 based
+        std::size_t size() const;
+        std::size_t memoryUsage() const;
+
+        bool write(std::ostream& out) const;
+        bool read(std::istream& in, std::size_t expected_bits); // fails on any other length
+
+    private:
+        std::vector<std::uint64_t> words;
+        std::vector<std::uint32_t> zero_samples;
+        std::size_t bit_count = 0;
+    };
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    BitVector louds;
+    BitVector terminal;
+    std::vector<char> labels; // label of the edge into node id, labels[0] unused (root)
+    std::size_t node_count;
+
+    std::size_t findChild(std::size_t node, char c) const;
+    std::size_t findPrefixNode(const std::string& prefix) const;
+    static bool validLouds(const BitVector& bits, std::size_t nodes); // structural check on load
+    void childRange(std::size_t node, std::size_t& first, std::size_t& count) const;
+    void collect(std::size_t node, std::string& current, std::vector<std::string>& out, std::size_t max_results) const;
+};
+
+#endif // LOUDS_HPP
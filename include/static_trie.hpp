@@ -0,0 +1,108 @@
+#ifndef STATIC_TRIE_HPP
+#define STATIC_TRIE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// read-only trie over constexpr tables generated at build time (see
+// src/gen_static_trie.cpp). nodes are in bfs order so each node's children are
+// contiguous and in label order: node i's children are first_child[i] ..
+// first_child[i] + child_count[i] - 1, labels[c] is the edge into c, and bit i of
+// terminal marks the end of a word. lookups never allocate and can run at compile time
+class StaticTrie {
+public:
+    constexpr StaticTrie(const std::uint32_t* first_child, const std::uint8_t* child_count,
+                         const char* labels, const std::uint64_t* terminal, std::size_t node_count)
+        : first_child(first_child), child_count(child_count), labels(labels),
+          terminal(terminal), node_count(node_count) {}
+
+    // check if a word exists
+    constexpr bool contains(std::string_view word) const {
+        if (word.empty()) return false;
+        std::size_t node = findPrefixNode(word);
+        return node != npos && isTerminal(node);
+    }
+
+    // get up to max_results words that start with prefix, in lexicographic order
+    std::vector<std::string> autocomplete(const std::string& prefix, std::size_t max_results = 10) const {
+        std::vector<std::string> results;
+        if (prefix.empty() || max_results == 0) return results;
+
+        std::size_t node = findPrefixNode(prefix);
+        if (node == npos) return results;
+
+        std::string current = prefix;
+        collect(node, current, results, max_results);
+        return results;
+    }
+
+    // every word in the table, in lexicographic order
+    std::vector<std::string> allWords() const {
+        std::vector<std::string> results;
+        std::string current;
+        if (node_count) collect(0, current, results, static_cast<std::size_t>(-1));
+        return results;
+    }
+
+    constexpr std::size_t nodeCount() const { return node_count; }
+    constexpr bool empty() const { return node_count == 0 || (child_count[0] == 0 && !isTerminal(0)); }
+
+    // below methods mirror the interface expected by main
+    bool search(const std::string& word) const { return contains(word); } // alias for contains
+    std::vector<std::string> autoComplete(const std::string& prefix) const { return autocomplete(prefix, 10); }
+
+    // bytes of read-only tables; nothing lives on the heap
+    constexpr std::size_t getMemoryUsage() const {
+        return node_count * (sizeof(std::uint32_t) + sizeof(std::uint8_t) + sizeof(char)) +
+               (node_count + 63) / 64 * sizeof(std::uint64_t);
+    }
+
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    const std::uint32_t* first_child;
+    const std::uint8_t* child_count;
+    const char* labels;
+    const std::uint64_t* terminal;
+    std::size_t node_count;
+
+    constexpr bool isTerminal(std::size_t node) const {
+        return (terminal[node / 64] >> (node % 64)) & 1;
+    }
+
+    constexpr std::size_t findChild(std::size_t node, char c) const {
+        std::size_t first = first_child[node];
+        for (std::size_t i = first; i < first + child_count[node]; ++i) {
+            if (labels[i] == c) return i;
+            if (labels[i] > c) break; // children are in label order
+        }
+        return npos;
+    }
+
+    constexpr std::size_t findPrefixNode(std::string_view prefix) const {
+        if (node_count == 0) return npos;
+        std::size_t node = 0;
+        for (char c : prefix) {
+            node = findChild(node, c);
+            if (node == npos) return npos;
+        }
+        return node;
+    }
+
+    void collect(std::size_t node, std::string& current, std::vector<std::string>& out, std::size_t max_results) const {
+        if (out.size() >= max_results) return;
+        if (isTerminal(node)) out.push_back(current);
+
+        std::size_t first = first_child[node];
+        for (std::size_t i = first; i < first + child_count[node] && out.size() < max_results; ++i) {
+            current.push_back(labels[i]);
+            collect(i, current, out, max_results);
+            current.pop_back();
+        }
+    }
+};
+
+#endif // STATIC_TRIE_HPP
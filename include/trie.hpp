@@ -2,13 +2,16 @@
 #ifndef TRIE_HPP
 #define TRIE_HPP
 #include <cstddef>
+#include <random>
 #include <string>
 #include <vector>
 using namespace std;
 class Trie{
+     friend class LoudsTrie; // reads the node layout to encode it
 private:
      struct Node{
         bool endTrie;
+        unsigned int words;
         Node* children[26];
         Node();
      };
@@ -23,13 +26,28 @@ public:
      bool search(string& word);
      vector<string> autocomplete(string& prefix);
      size_t getMemory();
+     // batched lookups: up to group keys walk the trie in lockstep and each
+     // step prefetches the next node, so cache misses of different keys overlap
+     void containsBatch(const vector<string>& words, vector<bool>& out, size_t group = 8);
+     void findPrefixBatch(const vector<string>& prefixes, vector<bool>& out, size_t group = 8);
+     // one page of completions; token is the last word of the previous page ("" for
+     // the first) and is replaced by the token for the next page ("" when done)
+     vector<string> autocompletePage(string& prefix, size_t pageSize, string& token);
+     // words below each node are kept on insert (the field sits in padding), so these
+     // never enumerate: count in O(|prefix|), select/sample skip whole subtrees.
+     // an empty prefix means every word
+     size_t countPrefix(string& prefix);
+     string select(string& prefix, size_t index);
+     string sample(string& prefix, mt19937& rng);
 private:
     Node* root;
     size_t nodeCnt;
-    Node* insert(Node* node, const char* word, size_t& cnt);
+    Node* insert(Node* node, const char* word, size_t& cnt, bool& added);
     bool contain(Node* node, const char* word);
     Node* findPre(Node* node, const char* pre);
     void collect(Node* node, string now, vector<string>& out, size_t max);
+    void collectAfter(Node* node, string now, const char* rest, vector<string>& out, size_t max);
     void destroy(Node* node);
+    void lookupBatch(const vector<string>& keys, vector<bool>& out, size_t group, bool whole);
 };
 #endif
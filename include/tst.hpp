@@ -1,8 +1,13 @@
 #ifndef TST_HPP
 #define TST_HPP
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <random>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 
 // this is the ternary search tree interface and implementation details
@@ -20,6 +25,20 @@ public:
     // get up to max_results words that start with prefix
     std::vector<std::string> autocomplete(const std::string& prefix, std::size_t max_results = 10) const;
 
+    // one page of completions in lexicographic order. token is the last word of the
+    // previous page ("" for the first page) and is replaced with the token for the
+    // next page ("" when there is none); resuming walks only the token's path
+    std::vector<std::string> autocompletePage(const std::string& prefix, std::size_t page_size, std::string& token) const;
+
+    // how many words start with prefix, select the index-th of them in lexicographic
+    // order ("" if out of range), or draw one uniformly at random. an empty prefix
+    // means every word, as in Trie and Dawg. with
+    // AUTOCOMPLETE_SUBTREE_COUNTS every node carries the word count of its subtree,
+    // making all three o(|prefix| + depth); without it they enumerate completions
+    std::size_t countPrefix(const std::string& prefix) const;
+    std::string select(const std::string& prefix, std::size_t index) const;
+    std::string sample(const std::string& prefix, std::mt19937& rng) const;
+
     // number of nodes in the tst (rough proxy for size)
     std::size_t nodeCount() const;
 
@@ -29,26 +48,84 @@ public:
     // below methods mirror the interface expected by main
     bool search(const std::string& word) const; // alias for contains
     std::vector<std::string> autoComplete(const std::string& prefix) const; // default sized autocomplete
-    std::size_t getMemoryUsage() const; // bytes used by nodes
+    std::size_t getMemoryUsage() const; // bytes used by nodes and the suffix pool
+
+    // tail compression: below its last branching point a word is kept as one node
+    // plus an inline tail in a shared suffix pool instead of a chain of eq nodes
+    std::size_t tailChars() const; // characters currently held in tails (nodes saved)
+    std::size_t suffixPoolBytes() const;
+
+    // access-adaptive mode: lookups count hits per node and rebalance() reshapes
+    // each level's sibling bst so hot characters sit near its top.
+    // queries take a shared lock while this is on, so flip it before sharing the tree
+    void setAdaptive(bool enabled);
+    bool adaptive() const;
+
+    // rebuild every sibling bst weighted by hit counts (no-op unless adaptive).
+    // runs under an exclusive lock so it can be called from a maintenance thread
+    void rebalance();
+
+    // batched lookups: up to group keys walk the tree in lockstep and every step
+    // prefetches the node it moves to, so cache misses of different keys overlap
+    void containsBatch(const std::vector<std::string>& words, std::vector<bool>& out, std::size_t group = 8) const;
+    void findPrefixBatch(const std::vector<std::string>& prefixes, std::vector<bool>& out, std::size_t group = 8) const;
+
+    // number of node comparisons a lookup of word costs, a tail memcmp counts as one
+    // (does not count as a hit)
+    std::size_t probeDepth(const std::string& word) const;
 
 private:
+    // a node with tail_len > 0 also holds the word ch + tail (read from the pool at
+    // tail_off) and has no eq child; isEnd still marks a word ending at ch itself
     struct Node {
         char ch;
         bool isEnd;
+        std::uint16_t tail_len;
+        mutable std::atomic<std::uint32_t> hits;
+#ifdef AUTOCOMPLETE_SUBTREE_COUNTS
+        std::uint32_t count; // words in this node's whole subtree (left, eq/tail and right), fills padding
+#endif
+        std::uint32_t tail_off;
         Node* left;
         Node* eq;
         Node* right;
-        explicit Node(char c) : ch(c), isEnd(false), left(nullptr), eq(nullptr), right(nullptr) {}
+        explicit Node(char c) : ch(c), isEnd(false), tail_len(0), hits(0),
+#ifdef AUTOCOMPLETE_SUBTREE_COUNTS
+            count(0),
+#endif
+            tail_off(0), left(nullptr), eq(nullptr), right(nullptr) {}
     };
 
     Node* root;
     std::size_t node_count;
+    std::string suffix_pool; // append only, split tails keep pointing into it
+    std::atomic<bool> adaptive_mode;
+    mutable std::shared_mutex rw_mutex;
 
     // helpers
-    static Node* insert(Node* node, const char* word, std::size_t& node_count_ref);
-    static bool contains(const Node* node, const char* word);
-    static const Node* findPrefixNode(const Node* node, const char* prefix);
-    static void collect(const Node* node, std::string& current, std::vector<std::string>& out, std::size_t max_results);
+    static Node* insert(Node* node, const char* word, std::size_t& node_count_ref, bool& added, std::string& pool);
+    static bool contains(const Node* node, const char* word, bool track_hits, const char* pool);
+    // tail_matched is how far into the returned node's tail the prefix reaches
+    static const Node* findPrefixNode(const Node* node, const char* prefix, const char* pool, std::size_t& tail_matched);
+    static void collect(const Node* node, std::string& current, std::vector<std::string>& out, std::size_t max_results, const char* pool);
+    static void collectBelow(const Node* node, std::string& current, std::vector<std::string>& out, std::size_t max_results, const char* pool);
+    static void collectAfter(const Node* node, std::string& current, const char* rest, std::vector<std::string>& out, std::size_t max_results, const char* pool);
+
+    static std::string_view tailOf(const Node* node, const char* pool) { return std::string_view(pool + node->tail_off, node->tail_len); }
+    static bool tailEquals(const Node* node, const char* rest, const char* pool);
+
+    void lookupBatch(const std::vector<std::string>& keys, std::vector<bool>& out, std::size_t group, bool whole) const;
+
+    std::size_t countPrefixUnlocked(const std::string& prefix) const;
+    std::string selectUnlocked(const std::string& prefix, std::size_t index) const;
+#ifdef AUTOCOMPLETE_SUBTREE_COUNTS
+    static std::uint32_t subtreeCount(const Node* node) { return node ? node->count : 0; }
+    // words at this node itself: the one ending at ch plus its tail word or eq subtree
+    static std::uint32_t ownCount(const Node* node) { return (node->isEnd ? 1 : 0) + (node->tail_len ? 1 : subtreeCount(node->eq)); }
+#endif
+
+    static Node* rebalanceLevel(Node* level_root);
+    static Node* buildWeighted(std::vector<Node*>& siblings, const std::vector<std::uint64_t>& weight_sums, std::size_t lo, std::size_t hi);
 
     static void destroy(Node* node);
 };
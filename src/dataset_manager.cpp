@@ -0,0 +1,160 @@
+#include "dataset_manager.hpp"
+#include "spsc_queue.hpp"
+#include "trie.hpp"
+#include "tst.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+using namespace std;
+
+DatasetManager::DatasetManager(const string& file) : filename(file) {}
+
+bool DatasetManager::loadDataset() {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Could not open file " << filename << endl;
+        return false;
+    }
+
+    string word;
+    while (getline(file, word)) {
+        if (normalize(word)) {
+            words.push_back(word);
+        }
+    }
+    file.close();
+
+    cout << "Successfully loaded " << words.size() << " words from dataset." << endl;
+    return true;
+}
+
+bool DatasetManager::loadPipelined(Trie* trie, TernarySearchTree* tst, size_t chunkSize) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Could not open file " << filename << endl;
+        return false;
+    }
+
+    // The reader owns every chunk; inserters only borrow them, nullptr ends the stream
+    typedef vector<string> Chunk;
+    const size_t queueDepth = 64;
+    vector<unique_ptr<Chunk>> chunks;
+    SpscQueue<Chunk*> trieQueue(queueDepth);
+    SpscQueue<Chunk*> tstQueue(queueDepth);
+
+    auto push = [](SpscQueue<Chunk*>& queue, Chunk* chunk) {
+        while (!queue.tryPush(chunk)) {
+            this_thread::yield();
+        }
+    };
+
+    vector<thread> inserters;
+    if (trie != nullptr) {
+        inserters.emplace_back([&trieQueue, trie]() {
+            Chunk* chunk;
+            while (true) {
+                if (!trieQueue.tryPop(chunk)) {
+                    this_thread::yield();
+                    continue;
+                }
+                if (chunk == nullptr) break;
+                for (auto& word : *chunk) {  // Trie::insert takes non-const but does not modify
+                    trie->insert(word);
+                }
+            }
+        });
+    }
+    if (tst != nullptr) {
+        inserters.emplace_back([&tstQueue, tst]() {
+            Chunk* chunk;
+            while (true) {
+                if (!tstQueue.tryPop(chunk)) {
+                    this_thread::yield();
+                    continue;
+                }
+                if (chunk == nullptr) break;
+                for (const auto& word : *chunk) {
+                    tst->insert(word);
+                }
+            }
+        });
+    }
+
+    auto publish = [&](Chunk* chunk) {
+        if (trie != nullptr) push(trieQueue, chunk);
+        if (tst != nullptr) push(tstQueue, chunk);
+    };
+
+    string word;
+    unique_ptr<Chunk> current(new Chunk());
+    current->reserve(chunkSize);
+    while (getline(file, word)) {
+        if (!normalize(word)) continue;
+        current->push_back(std::move(word));
+        if (current->size() == chunkSize) {
+            publish(current.get());
+            chunks.push_back(std::move(current));
+            current.reset(new Chunk());
+            current->reserve(chunkSize);
+        }
+    }
+    if (!current->empty()) {
+        publish(current.get());
+        chunks.push_back(std::move(current));
+    }
+    publish(nullptr);
+    file.close();
+
+    for (auto& inserter : inserters) {
+        inserter.join();
+    }
+
+    // Inserters are done with the chunks, hand their words over to the word list
+    for (auto& chunk : chunks) {
+        for (auto& w : *chunk) {
+            words.push_back(std::move(w));
+        }
+        chunk.reset();
+    }
+
+    cout << "Successfully loaded " << words.size() << " words from dataset." << endl;
+    return true;
+}
+
+const string& DatasetManager::getFilename() const {
+    return filename;
+}
+
+const vector<string>& DatasetManager::getWords() const {
+    return words;
+}
+
+vector<string> DatasetManager::sortUnique(vector<string> list) {
+    sort(list.begin(), list.end());
+    list.erase(unique(list.begin(), list.end()), list.end());
+    return list;
+}
+
+vector<string> DatasetManager::getSortedWords() const {
+    return sortUnique(words);
+}
+
+bool DatasetManager::normalize(string& word) {
+    // Clean the word (remove whitespace, convert to lowercase)
+    word.erase(remove_if(word.begin(), word.end(), ::isspace), word.end());
+    if (word.empty()) return false;
+    transform(word.begin(), word.end(), word.begin(), ::tolower);
+    return true;
+}
+
+vector<string> DatasetManager::getSample(int n) const {
+    if (n >= words.size()) return words;
+    vector<string> sample;
+    for (int i = 0; i < n && i < words.size(); i++) {
+        sample.push_back(words[i]);
+    }
+    return sample;
+}
@@ -0,0 +1,192 @@
+#include "dawg.hpp"
+
+// incremental construction of a minimal acyclic automaton from sorted input.
+// the path of the previous word stays "pending"; when the next word leaves that
+// path, the abandoned tail is minimized bottom up by looking each state up in a
+// register keyed on (isEnd, outgoing edges). registered states are appended to
+// the flat arrays right away since their children are already final
+
+Dawg::Dawg() : root(0), finished(false) {
+    pending.emplace_back(); // root
+}
+
+bool Dawg::insert(const std::string& word) {
+    if (finished || word.empty()) return false;
+    if (!previous.empty() && word <= previous) return false; // must be strictly increasing
+
+    // length of the prefix shared with the previous word
+    std::size_t common = 0;
+    while (common < word.size() && common < previous.size() && word[common] == previous[common]) {
+        ++common;
+    }
+
+    minimize(common);
+
+    for (std::size_t i = common; i < word.size(); ++i) {
+        pending.back().edges.push_back({word[i], 0});
+        pending.emplace_back();
+    }
+    pending.back().isEnd = true;
+    previous = word;
+    return true;
+}
+
+void Dawg::finish() {
+    if (finished) return;
+    minimize(0);
+    root = registerState(pending.front());
+    finished = true;
+
+    // builder state is no longer needed
+    pending.clear();
+    pending.shrink_to_fit();
+    previous.clear();
+    previous.shrink_to_fit();
+    std::unordered_map<std::string, std::uint32_t>().swap(registry);
+    states.shrink_to_fit();
+    edges.shrink_to_fit();
+}
+
+void Dawg::build(const std::vector<std::string>& sorted_words) {
+    for (const auto& word : sorted_words) {
+        insert(word);
+    }
+    finish();
+}
+
+bool Dawg::contains(const std::string& word) const {
+    if (word.empty()) return false;
+    const State* state = findPrefixState(word);
+    return state && state->isEnd;
+}
+
+std::vector<std::string> Dawg::autocomplete(const std::string& prefix, std::size_t max_results) const {
+    std::vector<std::string> results;
+    if (prefix.empty() || max_results == 0) return results;
+
+    const State* state = findPrefixState(prefix);
+    if (!state) return results;
+
+    std::string current = prefix;
+    collect(*state, current, results, max_results);
+    return results;
+}
+
+std::size_t Dawg::countPrefix(const std::string& prefix) const {
+    const State* state = findPrefixState(prefix);
+    return state ? state->word_count : 0;
+}
+
+std::string Dawg::select(const std::string& prefix, std::size_t index) const {
+    const State* state = findPrefixState(prefix);
+    if (!state || index >= state->word_count) return "";
+
+    // skip whole subtrees using their word counts instead of enumerating them
+    std::string current = prefix;
+    while (true) {
+        if (state->isEnd) {
+            if (index == 0) return current;
+            --index;
+        }
+        for (std::uint32_t i = 0; i < state->edge_count; ++i) {
+            const Edge& edge = edges[state->first_edge + i];
+            const State& next = states[edge.target];
+            if (index < next.word_count) {
+                current.push_back(edge.label);
+                state = &next;
+                break;
+            }
+            index -= next.word_count;
+        }
+    }
+}
+
+std::size_t Dawg::nodeCount() const { return states.size(); }
+
+std::size_t Dawg::edgeCount() const { return edges.size(); }
+
+std::size_t Dawg::wordCount() const { return finished ? states[root].word_count : 0; }
+
+bool Dawg::empty() const { return wordCount() == 0; }
+
+// interface-aligned convenience methods
+bool Dawg::search(const std::string& word) const { return contains(word); }
+
+std::vector<std::string> Dawg::autoComplete(const std::string& prefix) const {
+    // default to a small list
+    return autocomplete(prefix, 10);
+}
+
+std::size_t Dawg::getMemoryUsage() const {
+    return states.capacity() * sizeof(State) + edges.capacity() * sizeof(Edge);
+}
+
+// helpers
+void Dawg::minimize(std::size_t down_to) {
+    // pending[i] is the state after i characters of the previous word
+    while (pending.size() > down_to + 1) {
+        std::uint32_t id = registerState(pending.back());
+        pending.pop_back();
+        pending.back().edges.back().target = id;
+    }
+}
+
+std::uint32_t Dawg::registerState(const PendingState& state) {
+    // signature: end flag followed by (label, target id) for every edge
+    std::string key;
+    key.reserve(1 + state.edges.size() * (1 + sizeof(std::uint32_t)));
+    key.push_back(state.isEnd ? '1' : '0');
+    for (const auto& edge : state.edges) {
+        key.push_back(edge.label);
+        key.append(reinterpret_cast<const char*>(&edge.target), sizeof(edge.target));
+    }
+
+    auto found = registry.find(key);
+    if (found != registry.end()) return found->second;
+
+    State frozen;
+    frozen.first_edge = static_cast<std::uint32_t>(edges.size());
+    frozen.word_count = state.isEnd ? 1 : 0;
+    frozen.edge_count = static_cast<std::uint8_t>(state.edges.size());
+    frozen.isEnd = state.isEnd;
+    for (const auto& edge : state.edges) {
+        edges.push_back(edge);
+        frozen.word_count += states[edge.target].word_count;
+    }
+
+    std::uint32_t id = static_cast<std::uint32_t>(states.size());
+    states.push_back(frozen);
+    registry.emplace(std::move(key), id);
+    return id;
+}
+
+const Dawg::State* Dawg::findPrefixState(const std::string& prefix) const {
+    if (!finished) return nullptr;
+    const State* state = &states[root];
+    for (char c : prefix) {
+        const State* next = nullptr;
+        for (std::uint32_t i = 0; i < state->edge_count; ++i) {
+            const Edge& edge = edges[state->first_edge + i];
+            if (edge.label == c) {
+                next = &states[edge.target];
+                break;
+            }
+        }
+        if (!next) return nullptr;
+        state = next;
+    }
+    return state;
+}
+
+void Dawg::collect(const State& state, std::string& current, std::vector<std::string>& out, std::size_t max_results) const {
+    if (out.size() >= max_results) return;
+    if (state.isEnd) out.push_back(current);
+
+    // edges are stored in label order since input was sorted
+    for (std::uint32_t i = 0; i < state.edge_count && out.size() < max_results; ++i) {
+        const Edge& edge = edges[state.first_edge + i];
+        current.push_back(edge.label);
+        collect(states[edge.target], current, out, max_results);
+        current.pop_back();
+    }
+}
@@ -0,0 +1,155 @@
+// Build-time generator: turns a word list into a header with constexpr trie
+// tables for StaticTrie (see include/static_trie.hpp).
+//
+//   gen_static_trie <words-file> <output-header> <name>
+//
+// The header defines namespace <name> with the tables and a constexpr
+// StaticTrie called index. Words are normalized like DatasetManager does and
+// words with characters outside a-z are skipped, matching what Trie accepts.
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <memory>
+#include <queue>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+struct BuildNode {
+    bool terminal = false;
+    map<char, unique_ptr<BuildNode>> children;  // ordered, so bfs emits children in label order
+};
+
+int main(int argc, char* argv[]) {
+    if (argc != 4) {
+        cerr << "Usage: " << argv[0] << " <words-file> <output-header> <name>" << endl;
+        return 1;
+    }
+    string inputPath = argv[1];
+    string outputPath = argv[2];
+    string name = argv[3];
+
+    ifstream input(inputPath);
+    if (!input.is_open()) {
+        cerr << "Error: Could not open file " << inputPath << endl;
+        return 1;
+    }
+
+    BuildNode root;
+    size_t numWords = 0;
+    string firstWord;
+    string word;
+    while (getline(input, word)) {
+        // Clean the word (remove whitespace, convert to lowercase)
+        word.erase(remove_if(word.begin(), word.end(), ::isspace), word.end());
+        if (word.empty()) continue;
+        transform(word.begin(), word.end(), word.begin(), ::tolower);
+        if (any_of(word.begin(), word.end(), [](char c) { return c < 'a' || c > 'z'; })) {
+            cerr << "Skipping '" << word << "': only a-z is supported" << endl;
+            continue;
+        }
+
+        BuildNode* node = &root;
+        for (char c : word) {
+            unique_ptr<BuildNode>& child = node->children[c];
+            if (!child) child.reset(new BuildNode());
+            node = child.get();
+        }
+        if (!node->terminal) {
+            node->terminal = true;
+            numWords++;
+            if (firstWord.empty()) firstWord = word;
+        }
+    }
+
+    // Number nodes in bfs order so every node's children get consecutive ids
+    vector<uint32_t> firstChild;
+    vector<uint8_t> childCount;
+    vector<char> labels;
+    vector<bool> terminal;
+    queue<const BuildNode*> level;
+    level.push(&root);
+    labels.push_back('\0');  // root has no incoming edge
+    uint32_t nextId = 1;
+    while (!level.empty()) {
+        const BuildNode* node = level.front();
+        level.pop();
+        firstChild.push_back(nextId);
+        childCount.push_back(node->children.size());
+        terminal.push_back(node->terminal);
+        for (const auto& child : node->children) {
+            labels.push_back(child.first);
+            level.push(child.second.get());
+            nextId++;
+        }
+    }
+    size_t numNodes = firstChild.size();
+
+    ofstream out(outputPath);
+    if (!out.is_open()) {
+        cerr << "Error: Could not write " << outputPath << endl;
+        return 1;
+    }
+
+    string guard = name;
+    transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+    guard += "_HPP";
+
+    out << "// generated by gen_static_trie from " << inputPath << ", do not edit\n";
+    out << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+    out << "#include <cstddef>\n#include <cstdint>\n#include \"static_trie.hpp\"\n\n";
+    out << "namespace " << name << " {\n\n";
+
+    out << "inline constexpr std::size_t word_count = " << numWords << ";\n\n";
+
+    out << "inline constexpr std::uint32_t first_child[" << numNodes << "] = {";
+    for (size_t i = 0; i < numNodes; i++) {
+        out << (i % 16 ? " " : "\n    ") << firstChild[i] << ",";
+    }
+    out << "\n};\n\n";
+
+    out << "inline constexpr std::uint8_t child_count[" << numNodes << "] = {";
+    for (size_t i = 0; i < numNodes; i++) {
+        out << (i % 16 ? " " : "\n    ") << (int)childCount[i] << ",";
+    }
+    out << "\n};\n\n";
+
+    out << "inline constexpr char labels[" << numNodes << "] = {";
+    for (size_t i = 0; i < numNodes; i++) {
+        out << (i % 16 ? " " : "\n    ");
+        if (labels[i] == '\0') {
+            out << "'\\0',";
+        } else {
+            out << "'" << labels[i] << "',";
+        }
+    }
+    out << "\n};\n\n";
+
+    size_t numBlocks = (numNodes + 63) / 64;
+    out << "inline constexpr std::uint64_t terminal[" << numBlocks << "] = {";
+    for (size_t b = 0; b < numBlocks; b++) {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < 64 && b * 64 + i < numNodes; i++) {
+            if (terminal[b * 64 + i]) bits |= uint64_t(1) << i;
+        }
+        out << (b % 4 ? " " : "\n    ") << "0x" << hex << bits << dec << "ull,";
+    }
+    out << "\n};\n\n";
+
+    out << "inline constexpr StaticTrie index(first_child, child_count, labels, terminal, " << numNodes << ");\n\n";
+    if (!firstWord.empty()) {
+        out << "static_assert(index.contains(\"" << firstWord << "\"), \"static index lookup is broken\");\n\n";
+    }
+    out << "}  // namespace " << name << "\n\n#endif\n";
+
+    out.close();
+    if (out.fail()) {
+        cerr << "Error: Could not write " << outputPath << endl;
+        return 1;
+    }
+    cout << "Generated " << outputPath << ": " << numWords << " words, " << numNodes << " nodes" << endl;
+    return 0;
+}
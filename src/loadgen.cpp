@@ -0,0 +1,260 @@
+// Load generator for autocomplete_server: keeps a fixed number of pipelined
+// requests in flight on each connection and reports throughput and latency
+// percentiles. Latency is measured from queuing a request to reading its reply.
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "dataset_manager.hpp"
+
+using namespace std;
+using namespace chrono;
+
+namespace {
+
+struct Client {
+    int fd = -1;
+    string in;
+    string out;
+    deque<steady_clock::time_point> inFlight;
+    uint32_t events = 0;
+};
+
+int connectTcp(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    int on = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    return fd;
+}
+
+int connectUnix(const string& path) {
+    sockaddr_un addr = {};
+    if (path.size() >= sizeof(addr.sun_path)) return -1;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path.c_str());
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+double percentile(const vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t index = min(sorted.size() - 1, (size_t)(p / 100.0 * sorted.size()));
+    return sorted[index];
+}
+
+void printUsage(const char* program) {
+    cerr << "Usage: " << program << " <words-file> [--port N | --unix PATH] [--connections N]"
+         << " [--pipeline N] [--requests N] [--autocomplete PERCENT]" << endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    string filename = argv[1];
+    int port = 7878;
+    string unixPath;
+    int numConnections = 4;
+    size_t pipelineDepth = 16;
+    size_t totalRequests = 200000;
+    int autocompletePercent = 10;
+    for (int i = 2; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (arg == "--port") {
+            port = atoi(argv[++i]);
+        } else if (arg == "--unix") {
+            unixPath = argv[++i];
+        } else if (arg == "--connections") {
+            numConnections = max(1, atoi(argv[++i]));
+        } else if (arg == "--pipeline") {
+            pipelineDepth = max(1, atoi(argv[++i]));
+        } else if (arg == "--requests") {
+            totalRequests = max(1, atoi(argv[++i]));
+        } else if (arg == "--autocomplete") {
+            autocompletePercent = min(100, max(0, atoi(argv[++i])));
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    DatasetManager dataManager(filename);
+    if (!dataManager.loadDataset() || dataManager.getWords().empty()) {
+        return 1;
+    }
+
+    // Pre-build every request line so generation cost stays out of the measurement
+    const vector<string>& words = dataManager.getWords();
+    mt19937 rng(42);
+    uniform_int_distribution<size_t> pickWord(0, words.size() - 1);
+    uniform_int_distribution<int> pickKind(0, 99);
+    vector<string> lines;
+    lines.reserve(totalRequests);
+    for (size_t i = 0; i < totalRequests; i++) {
+        const string& word = words[pickWord(rng)];
+        if (pickKind(rng) < autocompletePercent) {
+            lines.push_back("A " + word.substr(0, 3) + " 10\n");
+        } else {
+            lines.push_back("S " + word + "\n");
+        }
+    }
+
+    int epollFd = epoll_create1(0);
+    vector<Client> clients(numConnections);
+    for (int i = 0; i < numConnections; i++) {
+        int fd = unixPath.empty() ? connectTcp(port) : connectUnix(unixPath);
+        if (fd < 0) {
+            cerr << "Error: Could not connect to "
+                 << (unixPath.empty() ? "127.0.0.1:" + to_string(port) : unixPath)
+                 << " (" << strerror(errno) << ")" << endl;
+            return 1;
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        clients[i].fd = fd;
+        clients[i].events = EPOLLIN;
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.u32 = i;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+    vector<double> latencies;
+    latencies.reserve(totalRequests);
+    size_t issued = 0;
+
+    auto flush = [&](int i) {
+        Client& client = clients[i];
+        while (!client.out.empty()) {
+            ssize_t n = send(client.fd, client.out.data(), client.out.size(), MSG_NOSIGNAL);
+            if (n <= 0) break;
+            client.out.erase(0, n);
+        }
+        uint32_t events = EPOLLIN | (client.out.empty() ? 0 : (uint32_t)EPOLLOUT);
+        if (events != client.events) {
+            epoll_event ev = {};
+            ev.events = events;
+            ev.data.u32 = i;
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, client.fd, &ev);
+            client.events = events;
+        }
+    };
+
+    auto refill = [&](int i) {
+        Client& client = clients[i];
+        while (client.inFlight.size() < pipelineDepth && issued < totalRequests) {
+            client.out += lines[issued++];
+            client.inFlight.push_back(steady_clock::now());
+        }
+        flush(i);
+    };
+
+    cout << "Sending " << totalRequests << " requests over " << numConnections << " connection(s), pipeline depth "
+         << pipelineDepth << ", " << autocompletePercent << "% autocomplete" << endl;
+
+    auto start = steady_clock::now();
+    for (int i = 0; i < numConnections; i++) {
+        refill(i);
+    }
+
+    epoll_event events[64];
+    while (latencies.size() < totalRequests) {
+        int n = epoll_wait(epollFd, events, 64, 5000);
+        if (n == 0) {
+            cerr << "Error: Server stopped responding" << endl;
+            return 1;
+        }
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            cerr << "epoll_wait: " << strerror(errno) << endl;
+            return 1;
+        }
+
+        for (int e = 0; e < n; e++) {
+            int i = events[e].data.u32;
+            Client& client = clients[i];
+            if (events[e].events & EPOLLOUT) {
+                flush(i);
+            }
+            if (!(events[e].events & (EPOLLIN | EPOLLHUP | EPOLLERR))) continue;
+
+            char buffer[65536];
+            ssize_t got = read(client.fd, buffer, sizeof(buffer));
+            if (got == 0 || (got < 0 && errno != EAGAIN && errno != EINTR)) {
+                cerr << "Error: Server closed the connection" << endl;
+                return 1;
+            }
+            if (got < 0) continue;
+            client.in.append(buffer, got);
+
+            // Every newline completes the oldest request on this connection
+            auto now = steady_clock::now();
+            size_t consumed = 0;
+            size_t newline;
+            while ((newline = client.in.find('\n', consumed)) != string::npos && !client.inFlight.empty()) {
+                latencies.push_back(duration_cast<nanoseconds>(now - client.inFlight.front()).count() / 1000.0);
+                client.inFlight.pop_front();
+                consumed = newline + 1;
+            }
+            client.in.erase(0, consumed);
+            refill(i);
+        }
+    }
+    auto end = steady_clock::now();
+
+    for (const auto& client : clients) {
+        close(client.fd);
+    }
+    close(epollFd);
+
+    double seconds = duration_cast<nanoseconds>(end - start).count() / 1e9;
+    sort(latencies.begin(), latencies.end());
+
+    cout << "\n" << string(50, '=') << endl;
+    cout << "LOAD TEST RESULTS" << endl;
+    cout << string(50, '=') << endl;
+    cout << left << setw(25) << "Requests" << latencies.size() << endl;
+    cout << left << setw(25) << "Elapsed (s)" << fixed << setprecision(3) << seconds << endl;
+    cout << left << setw(25) << "Throughput (req/s)" << fixed << setprecision(0) << latencies.size() / seconds << endl;
+    cout << left << setw(25) << "Latency p50 (μs)" << fixed << setprecision(1) << percentile(latencies, 50) << endl;
+    cout << left << setw(25) << "Latency p99 (μs)" << percentile(latencies, 99) << endl;
+    cout << left << setw(25) << "Latency p99.9 (μs)" << percentile(latencies, 99.9) << endl;
+    cout << left << setw(25) << "Latency max (μs)" << latencies.back() << endl;
+    cout << string(50, '=') << endl;
+    return 0;
+}
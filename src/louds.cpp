@@ -0,0 +1,270 @@
+#include "louds.hpp"
+#include "trie.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <queue>
+
+// louds layout: "10" for a virtual super root, then for every node in bfs order
+// one 1 per child followed by a 0. the 1 at position p belongs to node
+// rank1(p), and node k's child block starts right after the k-th zero. ones
+// before that block are start - (k + 1), so its first child is node start - k - 1
+
+namespace {
+const char kMagic[8] = {'L', 'O', 'U', 'D', 'S', 'v', '1', '\0'};
+const std::size_t kZeroSampleRate = 512;
+}
+
+// bit vector
+
+void LoudsTrie::BitVector::clear() {
+    words.clear();
+    zero_samples.clear();
+    bit_count = 0;
+}
+
+void LoudsTrie::BitVector::push_back(bool bit) {
+    if (bit_count % 64 == 0) words.push_back(0);
+    if (bit) words.back() |= std::uint64_t(1) << (bit_count % 64);
+    ++bit_count;
+}
+
+void LoudsTrie::BitVector::buildIndex() {
+    words.shrink_to_fit();
+    zero_samples.clear();
+
+    std::size_t zeros = 0;
+    for (std::size_t pos = 0; pos < bit_count; ++pos) {
+        if (get(pos)) continue;
+        if (zeros % kZeroSampleRate == 0) zero_samples.push_back(static_cast<std::uint32_t>(pos));
+        ++zeros;
+    }
+    zero_samples.shrink_to_fit();
+}
+
+bool LoudsTrie::BitVector::get(std::size_t pos) const {
+    return (words[pos / 64] >> (pos % 64)) & 1;
+}
+
+std::size_t LoudsTrie::BitVector::select0(std::size_t k) const {
+    // jump to the sampled zero, then count zeros a word at a time
+    std::size_t pos = zero_samples[k / kZeroSampleRate];
+    std::size_t remaining = k % kZeroSampleRate;
+    std::size_t w = pos / 64;
+    std::uint64_t zeros = ~words[w] & (~std::uint64_t(0) << (pos % 64));
+    while (true) {
+        std::size_t in_word = __builtin_popcountll(zeros);
+        if (remaining < in_word) break;
+        remaining -= in_word;
+        zeros = ~words[++w];
+    }
+    for (std::size_t i = 0; i < remaining; ++i) {
+        zeros &= zeros - 1; // drop lowest zero
+    }
+    return w * 64 + __builtin_ctzll(zeros);
+}
+
+std::size_t LoudsTrie::BitVector::size() const { return bit_count; }
+
+std::size_t LoudsTrie::BitVector::memoryUsage() const {
+    return words.capacity() * sizeof(std::uint64_t) + zero_samples.capacity() * sizeof(std::uint32_t);
+}
+
+bool LoudsTrie::BitVector::write(std::ostream& out) const {
+    std::uint64_t bits = bit_count;
+    out.write(reinterpret_cast<const char*>(&bits), sizeof(bits));
+    out.write(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(std::uint64_t));
+    return static_cast<bool>(out);
+}
+
+bool LoudsTrie::BitVector::read(std::istream& in, std::size_t expected_bits) {
+    clear();
+    std::uint64_t bits = 0;
+    if (!in.read(reinterpret_cast<char*>(&bits), sizeof(bits))) return false;
+    if (bits != expected_bits) return false; // checked before allocating anything
+    words.resize((bits + 63) / 64);
+    if (!in.read(reinterpret_cast<char*>(words.data()), words.size() * sizeof(std::uint64_t))) return false;
+    bit_count = bits;
+    buildIndex();
+    return true;
+}
+
+// louds trie
+
+LoudsTrie::LoudsTrie() : node_count(0) {}
+
+void LoudsTrie::build(const Trie& trie) {
+    louds.clear();
+    terminal.clear();
+    labels.clear();
+    node_count = 0;
+
+    if (trie.root != nullptr) {
+        louds.push_back(true); // super root
+        louds.push_back(false);
+        labels.push_back('\0'); // root has no incoming edge
+
+        std::queue<const Trie::Node*> level;
+        level.push(trie.root);
+        while (!level.empty()) {
+            const Trie::Node* node = level.front();
+            level.pop();
+            ++node_count;
+            terminal.push_back(node->endTrie);
+            for (int i = 0; i < 26; i++) {
+                if (node->children[i] == nullptr) {
+                    continue;
+                }
+                louds.push_back(true);
+                labels.push_back('a' + i);
+                level.push(node->children[i]);
+            }
+            louds.push_back(false);
+        }
+    }
+
+    louds.buildIndex();
+    terminal.buildIndex();
+    labels.shrink_to_fit();
+}
+
+bool LoudsTrie::contains(const std::string& word) const {
+    if (word.empty()) return false;
+    std::size_t node = findPrefixNode(word);
+    return node != npos && terminal.get(node);
+}
+
+std::vector<std::string> LoudsTrie::autocomplete(const std::string& prefix, std::size_t max_results) const {
+    std::vector<std::string> results;
+    if (prefix.empty() || max_results == 0) return results;
+
+    std::size_t node = findPrefixNode(prefix);
+    if (node == npos) return results;
+
+    std::string current = prefix;
+    collect(node, current, results, max_results);
+    return results;
+}
+
+bool LoudsTrie::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) return false;
+
+    std::uint64_t nodes = node_count;
+    out.write(kMagic, sizeof(kMagic));
+    out.write(reinterpret_cast<const char*>(&nodes), sizeof(nodes));
+    if (!louds.write(out) || !terminal.write(out)) return false;
+    out.write(labels.data(), labels.size());
+    return static_cast<bool>(out);
+}
+
+bool LoudsTrie::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    // read into temporaries so a rejected file leaves this trie untouched
+    char magic[sizeof(kMagic)];
+    std::uint64_t nodes = 0;
+    BitVector new_louds, new_terminal;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) return false;
+    if (!in.read(reinterpret_cast<char*>(&nodes), sizeof(nodes))) return false;
+    // every node stores a label byte, so a node count beyond the file size is corrupt
+    // and would otherwise size the allocations below
+    std::streampos header_end = in.tellg();
+    in.seekg(0, std::ios::end);
+    std::uint64_t file_size = static_cast<std::uint64_t>(in.tellg());
+    in.seekg(header_end);
+    if (nodes > file_size) return false;
+    // louds has "10" for the super root plus a 1 and a 0 per node; an empty trie has no bits
+    if (!new_louds.read(in, nodes ? 2 * nodes + 1 : 0) || !new_terminal.read(in, nodes)) return false;
+    if (!validLouds(new_louds, nodes)) return false;
+
+    std::vector<char> new_labels(nodes, '\0');
+    if (!in.read(new_labels.data(), new_labels.size())) return false;
+
+    louds = std::move(new_louds);
+    terminal = std::move(new_terminal);
+    labels = std::move(new_labels);
+    node_count = nodes;
+    return true;
+}
+
+bool LoudsTrie::validLouds(const BitVector& bits, std::size_t nodes) {
+    // nodes ones and nodes + 1 zeros, ending in a zero, and every child id (ones
+    // before its bit) above its parent id (zeros before it, minus one), so
+    // navigation stays in range and the walk cannot loop
+    std::size_t ones = 0, zeros = 0;
+    for (std::size_t pos = 0; pos < bits.size(); ++pos) {
+        if (!bits.get(pos)) {
+            ++zeros;
+            continue;
+        }
+        if (ones < zeros) return false;
+        ++ones;
+    }
+    if (nodes == 0) return true;
+    return ones == nodes && zeros == nodes + 1 && !bits.get(bits.size() - 1);
+}
+
+std::size_t LoudsTrie::nodeCount() const { return node_count; }
+
+bool LoudsTrie::empty() const { return node_count == 0; }
+
+double LoudsTrie::bitsPerNode() const {
+    if (node_count == 0) return 0.0;
+    return (louds.memoryUsage() + terminal.memoryUsage()) * 8.0 / node_count;
+}
+
+// interface-aligned convenience methods
+bool LoudsTrie::search(const std::string& word) const { return contains(word); }
+
+std::vector<std::string> LoudsTrie::autoComplete(const std::string& prefix) const {
+    // default to a small list
+    return autocomplete(prefix, 10);
+}
+
+std::size_t LoudsTrie::getMemoryUsage() const {
+    return louds.memoryUsage() + terminal.memoryUsage() + labels.capacity();
+}
+
+// helpers
+void LoudsTrie::childRange(std::size_t node, std::size_t& first, std::size_t& count) const {
+    std::size_t start = louds.select0(node) + 1;
+    std::size_t end = start;
+    while (louds.get(end)) ++end; // degree is at most 26, a short scan beats a second select
+    first = start - node - 1;
+    count = end - start;
+}
+
+std::size_t LoudsTrie::findChild(std::size_t node, char c) const {
+    std::size_t first, count;
+    childRange(node, first, count);
+    for (std::size_t i = first; i < first + count; ++i) {
+        if (labels[i] == c) return i;
+        if (labels[i] > c) break; // children are in label order
+    }
+    return npos;
+}
+
+std::size_t LoudsTrie::findPrefixNode(const std::string& prefix) const {
+    if (node_count == 0) return npos;
+    std::size_t node = 0;
+    for (char c : prefix) {
+        node = findChild(node, c);
+        if (node == npos) return npos;
+    }
+    return node;
+}
+
+void LoudsTrie::collect(std::size_t node, std::string& current, std::vector<std::string>& out, std::size_t max_results) const {
+    if (out.size() >= max_results) return;
+    if (terminal.get(node)) out.push_back(current);
+
+    std::size_t first, count;
+    childRange(node, first, count);
+    for (std::size_t i = first; i < first + count && out.size() < max_results; ++i) {
+        current.push_back(labels[i]);
+        collect(i, current, out, max_results);
+        current.pop_back();
+    }
+}
@@ -5,8 +5,21 @@
 #include <chrono>
 #include <iomanip>
 #include <algorithm>
+#include <random>
+#include <numeric>
+#include <cmath>
+#include <functional>
+#ifdef __linux__
+#include <malloc.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 #include "trie.hpp"
 #include "tst.hpp"
+#include "dawg.hpp"
+#include "louds.hpp"
+#include "dataset_manager.hpp"
+#include "keywords_index.hpp"
 
 using namespace std;
 using namespace chrono;
@@ -19,49 +32,90 @@ struct PerformanceMetrics {
     int numWords;
 };
 
-class DatasetManager {
-private:
-    vector<string> words;
-    string filename;
+// One row of the multi-engine table
+struct EngineResult {
+    string name;
+    PerformanceMetrics metrics;
+};
 
-public:
-    DatasetManager(const string& file) : filename(file) {}
-
-    bool loadDataset() {
-        ifstream file(filename);
-        if (!file.is_open()) {
-            cerr << "Error: Could not open file " << filename << endl;
-            return false;
-        }
-
-        string word;
-        while (getline(file, word)) {
-            // Clean the word (remove whitespace, convert to lowercase)
-            word.erase(remove_if(word.begin(), word.end(), ::isspace), word.end());
-            if (!word.empty()) {
-                transform(word.begin(), word.end(), word.begin(), ::tolower);
-                words.push_back(word);
-            }
+// Peak resident set size of this process in KB (VmHWM), 0 if unavailable
+static size_t peakMemoryKB() {
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return stoul(line.substr(6));
         }
-        file.close();
-
-        cout << "Successfully loaded " << words.size() << " words from dataset." << endl;
-        return true;
     }
+    return 0;
+}
 
-    const vector<string>& getWords() const {
-        return words;
+// Current resident set size in KB (VmRSS), 0 if unavailable
+static size_t currentMemoryKB() {
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line)) {
+        if (line.compare(0, 6, "VmRSS:") == 0) {
+            return stoul(line.substr(6));
+        }
     }
+    return 0;
+}
+
+// Resets VmHWM to the current RSS so the next phase gets its own peak (Linux only)
+static bool resetPeakMemory() {
+    ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+    clearRefs.close();
+    return !clearRefs.fail();
+}
 
-    vector<string> getSample(int n) const {
-        if (n >= words.size()) return words;
-        vector<string> sample;
-        for (int i = 0; i < n && i < words.size(); i++) {
-            sample.push_back(words[i]);
+// Result of one load strategy run by runIsolated
+struct LoadRun {
+    long long ms;
+    size_t peakGrowthKB;  // VmHWM minus RSS at the start, 0 if unavailable
+    size_t numWords;
+};
+
+// Runs load (which returns the number of words loaded) in a forked child so its peak
+// memory does not depend on heap memory that earlier phases of this process freed.
+// Falls back to running in-process, without a peak, when fork is unavailable
+static LoadRun runIsolated(const function<size_t()>& load) {
+    LoadRun run = {0, 0, 0};
+#ifdef __linux__
+    int fds[2];
+    if (pipe(fds) == 0) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            malloc_trim(0);
+            bool peakAvailable = resetPeakMemory();
+            size_t baseline = currentMemoryKB();
+            auto start = high_resolution_clock::now();
+            run.numWords = load();
+            auto end = high_resolution_clock::now();
+            run.ms = duration_cast<milliseconds>(end - start).count();
+            run.peakGrowthKB = peakAvailable ? peakMemoryKB() - baseline : 0;
+            ssize_t written = write(fds[1], &run, sizeof(run));
+            _exit(written == (ssize_t)sizeof(run) ? 0 : 1);
+        }
+        close(fds[1]);
+        if (pid > 0) {
+            bool ok = read(fds[0], &run, sizeof(run)) == (ssize_t)sizeof(run);
+            waitpid(pid, nullptr, 0);
+            close(fds[0]);
+            if (ok) return run;
+        } else {
+            close(fds[0]);
         }
-        return sample;
     }
-};
+#endif
+    auto start = high_resolution_clock::now();
+    run.numWords = load();
+    auto end = high_resolution_clock::now();
+    run.ms = duration_cast<milliseconds>(end - start).count();
+    return run;
+}
 
 class PerformanceTester {
 public:
@@ -121,6 +175,264 @@ public:
         return metrics;
     }
 
+    static PerformanceMetrics testDAWG(Dawg* structure, const vector<string>& words) {
+        PerformanceMetrics metrics = {0, 0, 0, 0};
+
+        // Build time includes sorting, which the other engines don't need
+        auto startInsert = high_resolution_clock::now();
+        structure->build(DatasetManager::sortUnique(words));
+        auto endInsert = high_resolution_clock::now();
+        auto durationInsert = duration_cast<microseconds>(endInsert - startInsert);
+        metrics.avgInsertionTime = durationInsert.count() / (double)words.size();
+
+        // Test search time
+        auto startSearch = high_resolution_clock::now();
+        for (const auto& word : words) {
+            structure->search(word);
+        }
+        auto endSearch = high_resolution_clock::now();
+        auto durationSearch = duration_cast<microseconds>(endSearch - startSearch);
+        metrics.avgSearchTime = durationSearch.count() / (double)words.size();
+
+        // Get memory usage
+        metrics.memoryUsage = structure->getMemoryUsage();
+        metrics.numWords = words.size();
+
+        return metrics;
+    }
+
+    // Encodes an already built Trie; "build" time is the encoding pass only
+    static PerformanceMetrics testLOUDS(LoudsTrie* structure, Trie* source, const vector<string>& words) {
+        PerformanceMetrics metrics = {0, 0, 0, 0};
+
+        auto startInsert = high_resolution_clock::now();
+        structure->build(*source);
+        auto endInsert = high_resolution_clock::now();
+        auto durationInsert = duration_cast<microseconds>(endInsert - startInsert);
+        metrics.avgInsertionTime = durationInsert.count() / (double)words.size();
+
+        // Test search time
+        auto startSearch = high_resolution_clock::now();
+        for (const auto& word : words) {
+            structure->search(word);
+        }
+        auto endSearch = high_resolution_clock::now();
+        auto durationSearch = duration_cast<microseconds>(endSearch - startSearch);
+        metrics.avgSearchTime = durationSearch.count() / (double)words.size();
+
+        // Get memory usage
+        metrics.memoryUsage = structure->getMemoryUsage();
+        metrics.numWords = words.size();
+
+        return metrics;
+    }
+
+    // Compiled-in keyword index vs a Trie built from the same words at startup.
+    // Queries are every keyword plus a near miss for each, repeated
+    static void testStaticIndex(int repetitions) {
+        vector<string> keywords = keywords_index::index.allWords();
+        vector<string> queries;
+        for (int r = 0; r < repetitions; r++) {
+            for (const auto& keyword : keywords) {
+                queries.push_back(keyword);
+                queries.push_back(keyword + "x");
+            }
+        }
+
+        PerformanceMetrics runtimeMetrics = {0, 0, 0, 0};
+        Trie runtimeTrie;
+        auto startInsert = high_resolution_clock::now();
+        for (auto word : keywords) {  // Need non-const for Trie::insert
+            runtimeTrie.insert(word);
+        }
+        auto endInsert = high_resolution_clock::now();
+        runtimeMetrics.avgInsertionTime = duration_cast<nanoseconds>(endInsert - startInsert).count() / 1000.0 / keywords.size();
+
+        auto startSearch = high_resolution_clock::now();
+        size_t runtimeHits = 0;
+        for (auto& query : queries) {
+            runtimeHits += runtimeTrie.search(query);
+        }
+        auto endSearch = high_resolution_clock::now();
+        runtimeMetrics.avgSearchTime = duration_cast<nanoseconds>(endSearch - startSearch).count() / 1000.0 / queries.size();
+        runtimeMetrics.memoryUsage = runtimeTrie.getMemory();
+        runtimeMetrics.numWords = keywords.size();
+
+        // Nothing to build: the tables are in the binary's read-only data
+        PerformanceMetrics staticMetrics = {0, 0, 0, 0};
+        startSearch = high_resolution_clock::now();
+        size_t staticHits = 0;
+        for (const auto& query : queries) {
+            staticHits += keywords_index::index.search(query);
+        }
+        endSearch = high_resolution_clock::now();
+        staticMetrics.avgSearchTime = duration_cast<nanoseconds>(endSearch - startSearch).count() / 1000.0 / queries.size();
+        staticMetrics.memoryUsage = keywords_index::index.getMemoryUsage();
+        staticMetrics.numWords = keywords.size();
+
+        cout << "\n" << keywords.size() << " compiled-in keywords, " << queries.size() << " lookups ("
+             << staticHits << " / " << runtimeHits << " hits)" << endl;
+        displayEngines({
+            {"Trie (runtime)", runtimeMetrics},
+            {"Static (build)", staticMetrics},
+        });
+    }
+
+    // Lookup throughput of containsBatch for growing group sizes, on shuffled
+    // queries so consecutive lookups don't share cache lines
+    static void testBatchThroughput(const vector<string>& words) {
+        Trie batchTrie;
+        TernarySearchTree batchTST;
+        for (auto word : words) {  // Need non-const for Trie::insert
+            batchTrie.insert(word);
+        }
+        for (const auto& word : words) {
+            batchTST.insert(word);
+        }
+
+        vector<string> queries = words;
+        mt19937 rng(3);
+        shuffle(queries.begin(), queries.end(), rng);
+
+        auto mlookups = [&](high_resolution_clock::time_point start, high_resolution_clock::time_point end) {
+            return queries.size() / (double)duration_cast<nanoseconds>(end - start).count() * 1000.0;
+        };
+
+        cout << "\n" << string(70, '=') << endl;
+        cout << "BATCHED LOOKUP THROUGHPUT (" << queries.size() << " shuffled queries)" << endl;
+        cout << string(70, '=') << endl;
+        cout << left << setw(30) << "Group size"
+             << setw(20) << "Trie (M/s)"
+             << setw(20) << "TST (M/s)" << endl;
+        cout << string(70, '-') << endl;
+
+        // One-at-a-time search as the reference row
+        auto start = high_resolution_clock::now();
+        for (auto& query : queries) {
+            batchTrie.search(query);
+        }
+        auto mid = high_resolution_clock::now();
+        for (const auto& query : queries) {
+            batchTST.search(query);
+        }
+        auto end = high_resolution_clock::now();
+        cout << left << setw(30) << "search() loop";
+        cout << setw(20) << fixed << setprecision(3) << mlookups(start, mid);
+        cout << setw(20) << fixed << setprecision(3) << mlookups(mid, end) << endl;
+
+        vector<bool> found;
+        for (size_t group : {1, 2, 4, 8, 16, 32, 64}) {
+            start = high_resolution_clock::now();
+            batchTrie.containsBatch(queries, found, group);
+            mid = high_resolution_clock::now();
+            batchTST.containsBatch(queries, found, group);
+            end = high_resolution_clock::now();
+            cout << left << setw(30) << group;
+            cout << setw(20) << fixed << setprecision(3) << mlookups(start, mid);
+            cout << setw(20) << fixed << setprecision(3) << mlookups(mid, end) << endl;
+        }
+        cout << string(70, '=') << endl;
+    }
+
+    // Draws query words with Zipf-distributed popularity (rank r has weight 1/r^s).
+    // Ranks are shuffled with rankSeed so hot words are not simply the alphabetically
+    // first ones; samples drawn with different sampleSeeds share the same hot words.
+    static vector<string> zipfQueries(const vector<string>& words, size_t count, double s,
+                                      unsigned rankSeed, unsigned sampleSeed) {
+        vector<string> queries;
+        if (words.empty()) return queries;
+
+        mt19937 rankRng(rankSeed);
+        vector<size_t> byRank(words.size());
+        iota(byRank.begin(), byRank.end(), 0);
+        shuffle(byRank.begin(), byRank.end(), rankRng);
+
+        mt19937 rng(sampleSeed);
+
+        vector<double> weights(words.size());
+        for (size_t r = 0; r < weights.size(); r++) {
+            weights[r] = 1.0 / pow(r + 1.0, s);
+        }
+        discrete_distribution<size_t> pick(weights.begin(), weights.end());
+
+        queries.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            queries.push_back(words[byRank[pick(rng)]]);
+        }
+        return queries;
+    }
+
+    static void testAdaptiveTST(const vector<string>& words, size_t numQueries) {
+        TernarySearchTree adaptiveTST;
+        for (const auto& word : words) {
+            adaptiveTST.insert(word);
+        }
+
+        // Warm-up and measured queries share the hot words but are separate samples.
+        // Measuring runs with adaptive mode off so it never feeds the hit counters.
+        vector<string> warmup = zipfQueries(words, numQueries, 1.0, 7, 1);
+        vector<string> measured = zipfQueries(words, numQueries, 1.0, 7, 2);
+
+        auto measure = [&](double& avgComparisons, double& avgTime) {
+            size_t comparisons = 0;
+            for (const auto& word : measured) {
+                comparisons += adaptiveTST.probeDepth(word);
+            }
+            avgComparisons = comparisons / (double)measured.size();
+
+            auto start = high_resolution_clock::now();
+            for (const auto& word : measured) {
+                adaptiveTST.contains(word);
+            }
+            auto end = high_resolution_clock::now();
+            avgTime = duration_cast<nanoseconds>(end - start).count() / 1000.0 / measured.size();
+        };
+
+        double beforeComparisons, beforeTime;
+        measure(beforeComparisons, beforeTime);
+
+        // With no hits recorded every character weighs the same, so this only balances
+        // the sibling BSTs (sorted input leaves them as long chains)
+        adaptiveTST.setAdaptive(true);
+        adaptiveTST.rebalance();
+        adaptiveTST.setAdaptive(false);
+        double balancedComparisons, balancedTime;
+        measure(balancedComparisons, balancedTime);
+
+        adaptiveTST.setAdaptive(true);
+        for (const auto& word : warmup) {
+            adaptiveTST.contains(word);
+        }
+        auto startRebalance = high_resolution_clock::now();
+        adaptiveTST.rebalance();
+        auto endRebalance = high_resolution_clock::now();
+        adaptiveTST.setAdaptive(false);
+
+        double afterComparisons, afterTime;
+        measure(afterComparisons, afterTime);
+
+        cout << "\n" << string(84, '=') << endl;
+        cout << "ADAPTIVE TST UNDER ZIPF WORKLOAD (s = 1.0, " << measured.size() << " queries)" << endl;
+        cout << string(84, '=') << endl;
+        cout << left << setw(30) << "Metric"
+             << setw(18) << "Insertion order"
+             << setw(18) << "Balanced, no hits"
+             << setw(18) << "Hit-weighted" << endl;
+        cout << string(84, '-') << endl;
+        cout << left << setw(30) << "Avg comparisons / contains";
+        cout << setw(18) << fixed << setprecision(2) << beforeComparisons;
+        cout << setw(18) << fixed << setprecision(2) << balancedComparisons;
+        cout << setw(18) << fixed << setprecision(2) << afterComparisons << endl;
+        cout << left << setw(30) << "Avg Search Time (μs)";
+        cout << setw(18) << fixed << setprecision(4) << beforeTime;
+        cout << setw(18) << fixed << setprecision(4) << balancedTime;
+        cout << setw(18) << fixed << setprecision(4) << afterTime << endl;
+        cout << string(84, '-') << endl;
+        cout << "Hit-weighted rebalance took " << duration_cast<milliseconds>(endRebalance - startRebalance).count()
+             << " ms" << endl;
+        cout << string(84, '=') << endl;
+    }
+
     static void displayComparison(const PerformanceMetrics& trieMetrics,
                                   const PerformanceMetrics& tstMetrics) {
         cout << "\n" << string(80, '=') << endl;
@@ -171,6 +483,32 @@ public:
              << " uses " << fixed << setprecision(2) << memoryRatio << "x less memory" << endl;
         cout << string(80, '=') << endl;
     }
+
+    static void displayEngines(const vector<EngineResult>& engines) {
+        if (engines.empty()) return;
+
+        size_t smallest = engines[0].metrics.memoryUsage;
+        for (const auto& engine : engines) {
+            smallest = min(smallest, engine.metrics.memoryUsage);
+        }
+
+        cout << "\n" << string(80, '=') << endl;
+        cout << "ALL ENGINES" << endl;
+        cout << string(80, '=') << endl;
+        cout << left << setw(20) << "Engine"
+             << setw(20) << "Avg Build (μs)"
+             << setw(20) << "Avg Search (μs)"
+             << setw(20) << "Memory (KB)" << endl;
+        cout << string(80, '-') << endl;
+        for (const auto& engine : engines) {
+            cout << left << setw(20) << engine.name;
+            cout << setw(20) << fixed << setprecision(4) << engine.metrics.avgInsertionTime;
+            cout << setw(20) << fixed << setprecision(4) << engine.metrics.avgSearchTime;
+            cout << fixed << setprecision(2) << (engine.metrics.memoryUsage / 1024.0)
+                 << " (" << (smallest ? engine.metrics.memoryUsage / (double)smallest : 0.0) << "x)" << endl;
+        }
+        cout << string(80, '=') << endl;
+    }
 };
 
 class MenuSystem {
@@ -200,6 +538,13 @@ public:
         cout << "9.  Compare performance (load sample)" << endl;
         cout << "10. Compare performance (full dataset)" << endl;
         cout << "11. Display memory usage" << endl;
+        cout << "12. Adaptive TST under Zipf workload" << endl;
+        cout << "13. Save/reload LOUDS encoding of Trie" << endl;
+        cout << "14. Compare two-phase vs pipelined load" << endl;
+        cout << "15. Batched lookup throughput vs group size" << endl;
+        cout << "16. Paginated auto-complete (Trie and TST)" << endl;
+        cout << "17. Count, select and sample completions" << endl;
+        cout << "18. Compiled-in keyword index vs runtime Trie" << endl;
         cout << "0.  Exit" << endl;
         cout << string(60, '=') << endl;
         cout << "Enter choice: ";
@@ -260,6 +605,33 @@ public:
                 case 11:
                     displayMemoryUsage();
                     break;
+                case 12:
+                    compareAdaptive();
+                    break;
+                case 13:
+                    cout << "Enter output filename: ";
+                    getline(cin, word);
+                    saveLOUDS(word);
+                    break;
+                case 14:
+                    compareLoad();
+                    break;
+                case 15:
+                    PerformanceTester::testBatchThroughput(dataManager->getWords());
+                    break;
+                case 16:
+                    cout << "Enter prefix for auto-complete: ";
+                    getline(cin, prefix);
+                    paginatedAutoComplete(prefix);
+                    break;
+                case 17:
+                    cout << "Enter prefix: ";
+                    getline(cin, prefix);
+                    countCompletions(prefix);
+                    break;
+                case 18:
+                    PerformanceTester::testStaticIndex(1000);
+                    break;
                 case 0:
                     cout << "Exiting program. Goodbye!" << endl;
                     return;
@@ -370,6 +742,86 @@ private:
              << duration.count() << " μs)" << endl;
     }
 
+    void paginatedAutoComplete(string prefix) {
+        transform(prefix.begin(), prefix.end(), prefix.begin(), ::tolower);
+        cout << "Enter page size: ";
+        int pageSize;
+        cin >> pageSize;
+        if (pageSize <= 0) {
+            cout << "Invalid page size." << endl;
+            return;
+        }
+
+        // Each call resumes from the token, so page N costs the same as page 1
+        string trieToken, tstToken;
+        for (int pageNum = 1; ; pageNum++) {
+            auto start = high_resolution_clock::now();
+            vector<string> triePage = trie->autocompletePage(prefix, pageSize, trieToken);
+            auto mid = high_resolution_clock::now();
+            vector<string> tstPage = tst->autocompletePage(prefix, pageSize, tstToken);
+            auto end = high_resolution_clock::now();
+
+            cout << "\nPage " << pageNum << " for '" << prefix << "':" << endl;
+            cout << left << setw(30) << "Trie" << "TST" << endl;
+            for (size_t i = 0; i < max(triePage.size(), tstPage.size()); i++) {
+                cout << left << setw(30) << (i < triePage.size() ? triePage[i] : "")
+                     << (i < tstPage.size() ? tstPage[i] : "") << endl;
+            }
+            cout << left << setw(30) << ("(" + to_string(duration_cast<microseconds>(mid - start).count()) + " μs)")
+                 << "(" << duration_cast<microseconds>(end - mid).count() << " μs)" << endl;
+
+            if (trieToken.empty() && tstToken.empty()) {
+                cout << "No more pages." << endl;
+                break;
+            }
+            cout << "Next page? (y/n): ";
+            char more;
+            cin >> more;
+            if (more != 'y' && more != 'Y') {
+                break;
+            }
+        }
+    }
+
+    void countCompletions(string prefix) {
+        transform(prefix.begin(), prefix.end(), prefix.begin(), ::tolower);
+
+        auto start = high_resolution_clock::now();
+        size_t trieCount = trie->countPrefix(prefix);
+        auto mid = high_resolution_clock::now();
+        size_t tstCount = tst->countPrefix(prefix);
+        auto end = high_resolution_clock::now();
+
+        // The old way: enumerate every completion just to count them
+        auto startEnum = high_resolution_clock::now();
+        size_t enumerated = trie->autocomplete(prefix, (size_t)-1).size();
+        auto endEnum = high_resolution_clock::now();
+
+        cout << "Words starting with '" << prefix << "':" << endl;
+        cout << "  Trie countPrefix: " << trieCount << " ("
+             << duration_cast<nanoseconds>(mid - start).count() << " ns)" << endl;
+        cout << "  TST countPrefix:  " << tstCount << " ("
+             << duration_cast<nanoseconds>(end - mid).count() << " ns)" << endl;
+        cout << "  Enumerating:      " << enumerated << " ("
+             << duration_cast<nanoseconds>(endEnum - startEnum).count() << " ns)" << endl;
+        if (trieCount == 0 && tstCount == 0) {
+            return;
+        }
+
+        size_t total = max(trieCount, tstCount);
+        cout << "First, middle and last completion (select):" << endl;
+        for (size_t index : {(size_t)0, total / 2, total - 1}) {
+            cout << "  #" << index << ": " << trie->select(prefix, index)
+                 << " / " << tst->select(prefix, index) << endl;
+        }
+
+        mt19937 rng(random_device{}());
+        cout << "Random completions (Trie / TST):" << endl;
+        for (int i = 0; i < 5; i++) {
+            cout << "  " << trie->sample(prefix, rng) << " / " << tst->sample(prefix, rng) << endl;
+        }
+    }
+
     void compareSample() {
         cout << "Enter sample size (e.g., 1000, 10000): ";
         int sampleSize;
@@ -391,8 +843,28 @@ private:
 
         PerformanceTester::displayComparison(trieMetrics, tstMetrics);
 
+        cout << "Testing DAWG..." << endl;
+        Dawg* freshDAWG = new Dawg();
+        PerformanceMetrics dawgMetrics = PerformanceTester::testDAWG(freshDAWG, sample);
+
+        cout << "Testing LOUDS..." << endl;
+        LoudsTrie* freshLOUDS = new LoudsTrie();
+        PerformanceMetrics loudsMetrics = PerformanceTester::testLOUDS(freshLOUDS, freshTrie, sample);
+
+        PerformanceTester::displayEngines({
+            {"Trie", trieMetrics},
+            {"TST", tstMetrics},
+            {"DAWG", dawgMetrics},
+            {"LOUDS", loudsMetrics},
+        });
+        cout << "LOUDS: " << freshLOUDS->nodeCount() << " nodes, " << fixed << setprecision(2)
+             << freshLOUDS->bitsPerNode() << " bits/node + 1 label byte/node (Trie node: "
+             << freshTrie->getMemory() / max<size_t>(freshTrie->cntNodes(), 1) << " bytes)" << endl;
+
         delete freshTrie;
         delete freshTST;
+        delete freshDAWG;
+        delete freshLOUDS;
     }
 
     void compareFull() {
@@ -421,8 +893,121 @@ private:
 
         PerformanceTester::displayComparison(trieMetrics, tstMetrics);
 
+        cout << "Testing DAWG..." << endl;
+        Dawg* freshDAWG = new Dawg();
+        PerformanceMetrics dawgMetrics = PerformanceTester::testDAWG(freshDAWG, allWords);
+
+        cout << "Testing LOUDS..." << endl;
+        LoudsTrie* freshLOUDS = new LoudsTrie();
+        PerformanceMetrics loudsMetrics = PerformanceTester::testLOUDS(freshLOUDS, freshTrie, allWords);
+
+        PerformanceTester::displayEngines({
+            {"Trie", trieMetrics},
+            {"TST", tstMetrics},
+            {"DAWG", dawgMetrics},
+            {"LOUDS", loudsMetrics},
+        });
+        cout << "LOUDS: " << freshLOUDS->nodeCount() << " nodes, " << fixed << setprecision(2)
+             << freshLOUDS->bitsPerNode() << " bits/node + 1 label byte/node (Trie node: "
+             << freshTrie->getMemory() / max<size_t>(freshTrie->cntNodes(), 1) << " bytes)" << endl;
+
         delete freshTrie;
         delete freshTST;
+        delete freshDAWG;
+        delete freshLOUDS;
+    }
+
+    void compareAdaptive() {
+        cout << "Enter number of queries (e.g., 100000): ";
+        int numQueries;
+        cin >> numQueries;
+        if (numQueries <= 0) {
+            cout << "Invalid number of queries." << endl;
+            return;
+        }
+
+        PerformanceTester::testAdaptiveTST(dataManager->getWords(), numQueries);
+    }
+
+    void saveLOUDS(const string& path) {
+        if (!trieLoaded) {
+            cout << "Load the dataset into the Trie first (option 1)." << endl;
+            return;
+        }
+
+        LoudsTrie encoded;
+        encoded.build(*trie);
+        if (!encoded.save(path)) {
+            cerr << "Error: Could not write " << path << endl;
+            return;
+        }
+
+        auto start = high_resolution_clock::now();
+        LoudsTrie reloaded;
+        bool ok = reloaded.load(path);
+        auto end = high_resolution_clock::now();
+        if (!ok) {
+            cerr << "Error: Could not read back " << path << endl;
+            return;
+        }
+
+        ifstream saved(path, ios::binary | ios::ate);
+        cout << "Saved " << reloaded.nodeCount() << " nodes to " << path << " ("
+             << (saved.tellg() / 1024.0) << " KB on disk, "
+             << (reloaded.getMemoryUsage() / 1024.0) << " KB in memory vs "
+             << (trie->getMemory() / 1024.0) << " KB for the Trie)" << endl;
+        cout << "Reloaded in " << duration_cast<microseconds>(end - start).count() << " μs" << endl;
+    }
+
+    void compareLoad() {
+        const string& filename = dataManager->getFilename();
+
+        // Each path runs in its own child process, so neither sees memory the other freed.
+        // The child exits right after, so the structures are deliberately not deleted
+        // (teardown stays out of the timing, as before)
+
+        // Two-phase: read and normalize everything, then build each structure in turn
+        LoadRun twoPhase = runIsolated([&filename]() {
+            DatasetManager* manager = new DatasetManager(filename);
+            manager->loadDataset();
+            Trie* trie = new Trie();
+            TernarySearchTree* tst = new TernarySearchTree();
+            for (auto word : manager->getWords()) {  // Need non-const copy
+                trie->insert(word);
+            }
+            for (const auto& word : manager->getWords()) {
+                tst->insert(word);
+            }
+            return manager->getWords().size();
+        });
+
+        // Pipelined: one pass, reader and both inserters run concurrently
+        LoadRun pipelined = runIsolated([&filename]() {
+            DatasetManager* manager = new DatasetManager(filename);
+            Trie* trie = new Trie();
+            TernarySearchTree* tst = new TernarySearchTree();
+            manager->loadPipelined(trie, tst);
+            return manager->getWords().size();
+        });
+
+        cout << "\n" << string(70, '=') << endl;
+        cout << "LOAD PIPELINE COMPARISON (" << pipelined.numWords << " words, Trie + TST)" << endl;
+        cout << string(70, '=') << endl;
+        cout << left << setw(30) << "Metric"
+             << setw(20) << "Two-phase"
+             << setw(20) << "Pipelined" << endl;
+        cout << string(70, '-') << endl;
+        cout << left << setw(30) << "End-to-end load (ms)"
+             << setw(20) << twoPhase.ms
+             << setw(20) << pipelined.ms << endl;
+        if (twoPhase.peakGrowthKB > 0 && pipelined.peakGrowthKB > 0) {
+            cout << left << setw(30) << "Peak memory growth (KB)"
+                 << setw(20) << twoPhase.peakGrowthKB
+                 << setw(20) << pipelined.peakGrowthKB << endl;
+        } else {
+            cout << "Peak memory: not available (needs fork and /proc/self/clear_refs)" << endl;
+        }
+        cout << string(70, '=') << endl;
     }
 
     void displayMemoryUsage() {
@@ -440,6 +1025,18 @@ private:
         if (tstLoaded) {
             size_t tstMemory = tst->getMemoryUsage();
             cout << "TST:  " << (tstMemory / 1024.0) << " KB" << endl;
+
+            // Each tail character is one eq-chain node the TST did not allocate
+            size_t totalProbes = 0;
+            for (const auto& word : dataManager->getWords()) {
+                totalProbes += tst->probeDepth(word);
+            }
+            cout << "  Nodes:            " << tst->nodeCount() << endl;
+            cout << "  Tail characters:  " << tst->tailChars() << endl;
+            cout << "  Suffix pool:      " << (tst->suffixPoolBytes() / 1024.0) << " KB" << endl;
+            cout << "  Avg comparisons:  " << fixed << setprecision(2)
+                 << (double)totalProbes / max((size_t)1, dataManager->getWords().size()) << endl;
+            cout.unsetf(ios::fixed);
         } else {
             cout << "TST:  Not loaded" << endl;
         }
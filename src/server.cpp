@@ -0,0 +1,443 @@
+// Standalone typeahead server: loads the dictionary once and answers a small
+// line protocol over TCP (loopback) and/or a Unix socket from one epoll loop.
+//
+//   S <word>            ->  "1" or "0"
+//   A <prefix> [max]    ->  completions separated by spaces (empty line if none)
+//   anything else       ->  "E"
+//
+// Everything read in one epoll round, pipelined requests on one connection as
+// well as requests from different connections, is answered as one batch.
+// Responses on a connection always come back in request order.
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "trie.hpp"
+#include "tst.hpp"
+#include "dataset_manager.hpp"
+
+using namespace std;
+
+namespace {
+
+const size_t kMaxLineLength = 4096;
+const size_t kMaxReadPerRound = 65536;   // per connection, epoll is level triggered so the rest waits
+const size_t kMaxOutputBacklog = 1 << 20;  // stop reading a client that is not reading its replies
+const size_t kMaxAutocomplete = 100;
+const int kMaxEvents = 256;
+
+volatile sig_atomic_t stopRequested = 0;
+
+void onSignal(int) {
+    stopRequested = 1;
+}
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+int listenTcp(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, SOMAXCONN) < 0 || !setNonBlocking(fd)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int listenUnix(const string& path) {
+    sockaddr_un addr = {};
+    if (path.size() >= sizeof(addr.sun_path)) return -1;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path.c_str());
+    unlink(path.c_str()); // stale socket from a previous run
+    if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, SOMAXCONN) < 0 || !setNonBlocking(fd)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+struct Connection {
+    string in;
+    string out;
+    uint32_t events = EPOLLIN;  // what the fd is currently registered for
+    bool closing = false;  // peer hung up, close once out is flushed
+};
+
+struct Request {
+    int fd;
+    char kind;  // 'S', 'A' or 'E'
+    string arg;
+    size_t max;
+};
+
+class QueryServer {
+private:
+    Trie* trie;
+    TernarySearchTree* tst;
+    bool useTrie;
+    int epollFd;
+    vector<int> listeners;
+    unordered_map<int, Connection> connections;
+    vector<Request> batch;
+
+    size_t totalRequests;
+    size_t totalBatches;
+    size_t largestBatch;
+
+public:
+    QueryServer(Trie* t, TernarySearchTree* ts, bool trieEngine)
+        : trie(t), tst(ts), useTrie(trieEngine), epollFd(epoll_create1(0)),
+          totalRequests(0), totalBatches(0), largestBatch(0) {}
+
+    ~QueryServer() {
+        for (auto& entry : connections) {
+            close(entry.first);
+        }
+        for (int fd : listeners) {
+            close(fd);
+        }
+        close(epollFd);
+    }
+
+    bool addListener(int fd) {
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) return false;
+        listeners.push_back(fd);
+        return true;
+    }
+
+    void run() {
+        epoll_event events[kMaxEvents];
+        while (!stopRequested) {
+            int n = epoll_wait(epollFd, events, kMaxEvents, -1);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                cerr << "epoll_wait: " << strerror(errno) << endl;
+                return;
+            }
+
+            for (int i = 0; i < n; i++) {
+                int fd = events[i].data.fd;
+                if (find(listeners.begin(), listeners.end(), fd) != listeners.end()) {
+                    acceptAll(fd);
+                    continue;
+                }
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                    readAll(fd);
+                }
+                if (events[i].events & EPOLLOUT) {
+                    flush(fd);
+                }
+            }
+
+            if (!batch.empty()) {
+                executeBatch();
+            }
+        }
+    }
+
+    void printStats() const {
+        cout << "Served " << totalRequests << " requests in " << totalBatches << " batches (avg "
+             << (totalBatches ? totalRequests / (double)totalBatches : 0.0) << ", max "
+             << largestBatch << " per batch)" << endl;
+    }
+
+private:
+    void acceptAll(int listenFd) {
+        while (true) {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) return;  // EAGAIN: accepted everything pending
+            setNonBlocking(fd);
+            int on = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));  // fails harmlessly on unix sockets
+
+            epoll_event ev = {};
+            ev.events = EPOLLIN;
+            ev.data.fd = fd;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+            connections[fd];
+        }
+    }
+
+    void readAll(int fd) {
+        auto it = connections.find(fd);
+        if (it == connections.end()) return;
+        Connection& conn = it->second;
+
+        char buffer[16384];
+        size_t readThisRound = 0;
+        while (readThisRound < kMaxReadPerRound) {
+            ssize_t got = read(fd, buffer, sizeof(buffer));
+            if (got > 0) {
+                readThisRound += got;
+                conn.in.append(buffer, got);
+                parseLines(fd, conn);
+                if (conn.in.size() > kMaxLineLength) {
+                    conn.closing = true;  // no newline in sight, drop the client
+                    conn.in.clear();
+                    break;
+                }
+                continue;
+            }
+            if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            if (got < 0 && errno == EINTR) continue;
+            conn.closing = true;  // EOF or hard error
+            break;
+        }
+
+        if (conn.closing && conn.out.empty() && !hasPending(fd)) {
+            closeConnection(fd);
+        }
+    }
+
+    void parseLines(int fd, Connection& conn) {
+        size_t start = 0;
+        size_t newline;
+        while ((newline = conn.in.find('\n', start)) != string::npos) {
+            string line = conn.in.substr(start, newline - start);
+            start = newline + 1;
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+
+            Request request = {fd, 'E', "", 0};
+            if (line.size() > 2 && (line[0] == 'S' || line[0] == 'A') && line[1] == ' ') {
+                request.kind = line[0];
+                request.arg = line.substr(2);
+                if (request.kind == 'A') {
+                    request.max = 10;
+                    size_t space = request.arg.find(' ');
+                    if (space != string::npos) {
+                        request.max = min(kMaxAutocomplete, (size_t)strtoul(request.arg.c_str() + space + 1, nullptr, 10));
+                        request.arg.erase(space);
+                    }
+                }
+                transform(request.arg.begin(), request.arg.end(), request.arg.begin(), ::tolower);
+            }
+            batch.push_back(std::move(request));
+        }
+        conn.in.erase(0, start);
+    }
+
+    bool hasPending(int fd) const {
+        for (const auto& request : batch) {
+            if (request.fd == fd) return true;
+        }
+        return false;
+    }
+
+    void executeBatch() {
+        // All lookups of the batch go through one interleaved containsBatch call
+        vector<string> lookups;
+        for (auto& request : batch) {
+            if (request.kind == 'S') lookups.push_back(std::move(request.arg));  // arg is not needed again
+        }
+        vector<bool> found;
+        if (useTrie) {
+            trie->containsBatch(lookups, found);
+        } else {
+            tst->containsBatch(lookups, found);
+        }
+        size_t nextLookup = 0;
+
+        vector<int> touched;
+        for (size_t i = 0; i < batch.size(); i++) {
+            Request& request = batch[i];
+            // Consume the lookup result even if the connection is gone, later replies depend on it
+            bool hit = request.kind == 'S' && found[nextLookup++];
+            auto it = connections.find(request.fd);
+            if (it == connections.end()) continue;
+            string& out = it->second.out;
+
+            if (request.kind == 'S') {
+                out += hit ? "1\n" : "0\n";
+            } else if (request.kind == 'A') {
+                vector<string> suggestions = useTrie ? trie->autocomplete(request.arg, request.max)
+                                                     : tst->autocomplete(request.arg, request.max);
+                for (size_t j = 0; j < suggestions.size(); j++) {
+                    if (j) out += ' ';
+                    out += suggestions[j];
+                }
+                out += '\n';
+            } else {
+                out += "E\n";
+            }
+            if (touched.empty() || touched.back() != request.fd) touched.push_back(request.fd);
+        }
+
+        totalRequests += batch.size();
+        totalBatches++;
+        largestBatch = max(largestBatch, batch.size());
+        batch.clear();
+
+        sort(touched.begin(), touched.end());
+        touched.erase(unique(touched.begin(), touched.end()), touched.end());
+        for (int fd : touched) {
+            flush(fd);
+        }
+    }
+
+    void flush(int fd) {
+        auto it = connections.find(fd);
+        if (it == connections.end()) return;
+        Connection& conn = it->second;
+
+        size_t sent = 0;
+        while (sent < conn.out.size()) {
+            ssize_t n = send(fd, conn.out.data() + sent, conn.out.size() - sent, MSG_NOSIGNAL);
+            if (n > 0) {
+                sent += n;
+                continue;
+            }
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            closeConnection(fd);
+            return;
+        }
+        conn.out.erase(0, sent);
+
+        if (conn.out.empty() && conn.closing) {
+            closeConnection(fd);
+            return;
+        }
+
+        // Only ask for EPOLLOUT while there is a backlog. Stop reading a hung up peer, and one
+        // whose unread replies pass kMaxOutputBacklog until draining them re-arms EPOLLIN here
+        bool readable = !conn.closing && conn.out.size() < kMaxOutputBacklog;
+        uint32_t events = (readable ? (uint32_t)EPOLLIN : 0) | (conn.out.empty() ? 0 : (uint32_t)EPOLLOUT);
+        if (events != conn.events) {
+            epoll_event ev = {};
+            ev.events = events;
+            ev.data.fd = fd;
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+            conn.events = events;
+        }
+    }
+
+    void closeConnection(int fd) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connections.erase(fd);
+        // Drop its queued requests, accept() may hand the same fd number to a new client this round
+        batch.erase(remove_if(batch.begin(), batch.end(), [fd](const Request& request) { return request.fd == fd; }),
+                    batch.end());
+    }
+};
+
+void printUsage(const char* program) {
+    cerr << "Usage: " << program << " <words-file> [--engine trie|tst] [--port N] [--unix PATH]" << endl;
+    cerr << "Listens on 127.0.0.1:7878 unless --port or --unix is given." << endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    string filename = argv[1];
+    string engine = "trie";
+    int port = -1;
+    string unixPath;
+    for (int i = 2; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--engine" && i + 1 < argc) {
+            engine = argv[++i];
+        } else if (arg == "--port" && i + 1 < argc) {
+            port = atoi(argv[++i]);
+        } else if (arg == "--unix" && i + 1 < argc) {
+            unixPath = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (engine != "trie" && engine != "tst") {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (port < 0 && unixPath.empty()) port = 7878;
+
+    DatasetManager dataManager(filename);
+    if (!dataManager.loadDataset()) {
+        return 1;
+    }
+
+    Trie* trie = new Trie();
+    TernarySearchTree* tst = new TernarySearchTree();
+    if (engine == "trie") {
+        for (auto word : dataManager.getWords()) {  // Need non-const copy
+            trie->insert(word);
+        }
+    } else {
+        for (const auto& word : dataManager.getWords()) {
+            tst->insert(word);
+        }
+    }
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    signal(SIGPIPE, SIG_IGN);
+
+    int status = 0;
+    {
+        QueryServer server(trie, tst, engine == "trie");
+        if (port >= 0) {
+            int fd = listenTcp(port);
+            if (fd < 0 || !server.addListener(fd)) {
+                cerr << "Error: Could not listen on 127.0.0.1:" << port << " (" << strerror(errno) << ")" << endl;
+                status = 1;
+            } else {
+                cout << "Listening on 127.0.0.1:" << port << endl;
+            }
+        }
+        if (status == 0 && !unixPath.empty()) {
+            int fd = listenUnix(unixPath);
+            if (fd < 0 || !server.addListener(fd)) {
+                cerr << "Error: Could not listen on " << unixPath << " (" << strerror(errno) << ")" << endl;
+                status = 1;
+            } else {
+                cout << "Listening on " << unixPath << endl;
+            }
+        }
+
+        if (status == 0) {
+            cout << "Serving " << engine << " (Ctrl-C to stop)" << endl;
+            server.run();
+            server.printStats();
+        }
+    }
+    if (!unixPath.empty()) unlink(unixPath.c_str());
+
+    delete trie;
+    delete tst;
+    return status;
+}
@@ -6,6 +6,7 @@
 using namespace std;
 Trie::Node::Node() {
     endTrie = false;
+    words = 0;
     for (int i = 0; i < 26; i++) {
         children[i] = nullptr;
     }
@@ -24,7 +25,8 @@ void Trie::insert(string& word) {
         return;
     }
     const char* str = word.c_str();
-    Node* update = insert(root, str, nodeCnt);
+    bool added = false;
+    Node* update = insert(root, str, nodeCnt, added);
     root = update;
 }
 bool Trie::contain(string& word)  {
@@ -51,28 +53,58 @@ vector<string> Trie::autocomplete(string& prefix, size_t max) {
     return final;
     }
     string now = prefix;
-    if (node->endTrie) {
-    final.push_back(prefix);
-    } 
     collect(node, now, final, max);
     return final;
 }
-Trie::Node* Trie::insert(Node* node, const char* word, size_t& cnt) {
+vector<string> Trie::autocompletePage(string& prefix, size_t pageSize, string& token) {
+    vector<string> page;
+    string resume = token;
+    token.clear();
+    if (root == nullptr || prefix.empty() || pageSize == 0) {
+        return page;
+    }
+    if (resume.size() > 0 && resume.compare(0, prefix.size(), prefix) != 0) {
+        return page;
+    }
+    Node* node = findPre(root, prefix.c_str());
+    if (node == nullptr) {
+        return page;
+    }
+    size_t want = pageSize + 1;
+    if (resume.empty()) {
+        collect(node, prefix, page, want);
+    } else {
+        collectAfter(node, prefix, resume.c_str() + prefix.size(), page, want);
+    }
+    if (page.size() > pageSize) {
+        page.pop_back();
+        token = page.back();
+    }
+    return page;
+}
+Trie::Node* Trie::insert(Node* node, const char* word, size_t& cnt, bool& added) {
     if (node == nullptr) {
         node = new Node();
         cnt = cnt + 1;
     }
     char val = *word;
     if (val == '\0') {
-        node->endTrie = true;
+        if (!node->endTrie) {
+            node->endTrie = true;
+            node->words++;
+            added = true;
+        }
         return node;
     }
     if (val < 'a' || val > 'z') {
         return node;
     }
     int ind = val - 'a'; 
-    Node* kid = insert(node->children[ind], word + 1, cnt);
+    Node* kid = insert(node->children[ind], word + 1, cnt, added);
     node->children[ind] = kid;
+    if (added) {
+        node->words++;
+    }
     return node;
 }
 bool Trie::contain( Node* node, const char* word) {
@@ -130,6 +162,83 @@ void Trie::collect( Node* node, string now, vector<string>& out, size_t max) {
         now.pop_back();
     }
 }
+void Trie::collectAfter(Node* node, string now, const char* rest, vector<string>& out, size_t max) {
+    if (node == nullptr) {
+        return;
+    }
+    if (out.size() >= max) {
+        return;
+    }
+    char val = *rest;
+    if (val == '\0') {
+        for (int i = 0; i < 26; i++) {
+            if (node->children[i] == nullptr) {
+                continue;
+            }
+            now.push_back('a' + i);
+            collect(node->children[i], now, out, max);
+            now.pop_back();
+        }
+        return;
+    }
+    if (val < 'a' || val > 'z') {
+        return;
+    }
+    int ind = val - 'a';
+    now.push_back(val);
+    collectAfter(node->children[ind], now, rest + 1, out, max);
+    now.pop_back();
+    for (int i = ind + 1; i < 26; i++) {
+        if (node->children[i] == nullptr) {
+            continue;
+        }
+        now.push_back('a' + i);
+        collect(node->children[i], now, out, max);
+        now.pop_back();
+    }
+}
+size_t Trie::countPrefix(string& prefix) {
+    Node* node = findPre(root, prefix.c_str());
+    if (node == nullptr) {
+        return 0;
+    }
+    return node->words;
+}
+string Trie::select(string& prefix, size_t index) {
+    Node* node = findPre(root, prefix.c_str());
+    if (node == nullptr || index >= node->words) {
+        return "";
+    }
+    string now = prefix;
+    while (true) {
+        if (node->endTrie) {
+            if (index == 0) {
+                return now;
+            }
+            index--;
+        }
+        for (int i = 0; i < 26; i++) {
+            Node* kid = node->children[i];
+            if (kid == nullptr) {
+                continue;
+            }
+            if (index < kid->words) {
+                now.push_back('a' + i);
+                node = kid;
+                break;
+            }
+            index -= kid->words;
+        }
+    }
+}
+string Trie::sample(string& prefix, mt19937& rng) {
+    size_t total = countPrefix(prefix);
+    if (total == 0) {
+        return "";
+    }
+    uniform_int_distribution<size_t> pick(0, total - 1);
+    return select(prefix, pick(rng));
+}
 size_t Trie::cntNodes() { 
     return nodeCnt; 
 }
@@ -155,3 +264,80 @@ void Trie::destroy(Node* node) {
         return;
     }
 }
+void Trie::containsBatch(const vector<string>& words, vector<bool>& out, size_t group) {
+    lookupBatch(words, out, group, true);
+}
+void Trie::findPrefixBatch(const vector<string>& prefixes, vector<bool>& out, size_t group) {
+    lookupBatch(prefixes, out, group, false);
+}
+void Trie::lookupBatch(const vector<string>& keys, vector<bool>& out, size_t group, bool whole) {
+    out.assign(keys.size(), false);
+    if (root == nullptr) {
+        return;
+    }
+    if (group == 0) {
+        group = 1;
+    }
+    // one lane per in-flight key, a finished lane picks up the next key
+    vector<Node*> node(group, nullptr);
+    vector<const char*> pos(group, nullptr);
+    vector<size_t> key(group, 0);
+    size_t next = 0;
+    size_t busy = 0;
+    for (size_t l = 0; l < group; l++) {
+        while (next < keys.size() && keys[next].empty()) {
+            next++;
+        }
+        if (next == keys.size()) {
+            break;
+        }
+        node[l] = root;
+        pos[l] = keys[next].c_str();
+        key[l] = next++;
+        busy++;
+    }
+    while (busy > 0) {
+        for (size_t l = 0; l < group; l++) {
+            if (pos[l] == nullptr) {
+                continue;
+            }
+            bool done = false;
+            char val = *pos[l];
+            if (val == '\0') {
+                out[key[l]] = whole ? node[l]->endTrie : true;
+                done = true;
+            } else if (val < 'a' || val > 'z') {
+                done = true;
+            } else {
+                Node* kid = node[l]->children[val - 'a'];
+                pos[l]++;
+                if (kid == nullptr) {
+                    done = true;
+                } else {
+                    // the next step reads kid's slot for the following char (or its end flag)
+                    char after = *pos[l];
+                    if (after >= 'a' && after <= 'z') {
+                        __builtin_prefetch(&kid->children[after - 'a']);
+                    } else {
+                        __builtin_prefetch(&kid->endTrie);
+                    }
+                    node[l] = kid;
+                }
+            }
+            if (!done) {
+                continue;
+            }
+            while (next < keys.size() && keys[next].empty()) {
+                next++;
+            }
+            if (next < keys.size()) {
+                node[l] = root;
+                pos[l] = keys[next].c_str();
+                key[l] = next++;
+            } else {
+                pos[l] = nullptr;
+                busy--;
+            }
+        }
+    }
+}
@@ -1,37 +1,115 @@
 #include "tst.hpp"
 
+#include <cstring>
+#include <mutex>
+
 // tiny tst implementation for autocomplete stuff
 
 // basic ctor/dtor
-TernarySearchTree::TernarySearchTree() : root(nullptr), node_count(0) {}
+TernarySearchTree::TernarySearchTree() : root(nullptr), node_count(0), adaptive_mode(false) {}
 TernarySearchTree::~TernarySearchTree() { destroy(root); root = nullptr; node_count = 0; }
 
 void TernarySearchTree::insert(const std::string& word) {
     if (word.empty()) return; // ignore empty
-    root = insert(root, word.c_str(), node_count);
+    std::unique_lock<std::shared_mutex> lock(rw_mutex, std::defer_lock);
+    if (adaptive_mode.load(std::memory_order_relaxed)) lock.lock();
+    bool added = false;
+    root = insert(root, word.c_str(), node_count, added, suffix_pool);
 }
 
 bool TernarySearchTree::contains(const std::string& word) const {
     if (word.empty()) return false;
-    return contains(root, word.c_str());
+    if (!adaptive_mode.load(std::memory_order_relaxed)) return contains(root, word.c_str(), false, suffix_pool.data());
+    std::shared_lock<std::shared_mutex> lock(rw_mutex);
+    return contains(root, word.c_str(), true, suffix_pool.data());
 }
 
 std::vector<std::string> TernarySearchTree::autocomplete(const std::string& prefix, std::size_t max_results) const {
     std::vector<std::string> results;
-    if (!root || prefix.empty() || max_results == 0) return results;
+    if (prefix.empty() || max_results == 0) return results;
+
+    std::shared_lock<std::shared_mutex> lock(rw_mutex, std::defer_lock);
+    if (adaptive_mode.load(std::memory_order_relaxed)) lock.lock();
+    if (!root) return results; // rebalance() swaps root under the lock
 
-    const Node* node = findPrefixNode(root, prefix.c_str());
+    std::size_t tail_matched = 0;
+    const Node* node = findPrefixNode(root, prefix.c_str(), suffix_pool.data(), tail_matched);
     if (!node) return results;
 
     std::string current = prefix;
+    if (tail_matched > 0) {
+        // prefix ends inside a tail, the tail word is the only completion
+        current.append(tailOf(node, suffix_pool.data()).substr(tail_matched));
+        results.push_back(current);
+        return results;
+    }
     if (node->isEnd) {
         results.push_back(prefix);
         if (results.size() >= max_results) return results;
     }
-    collect(node->eq, current, results, max_results);
+    collectBelow(node, current, results, max_results, suffix_pool.data());
     return results;
 }
 
+std::vector<std::string> TernarySearchTree::autocompletePage(const std::string& prefix, std::size_t page_size, std::string& token) const {
+    std::vector<std::string> page;
+    std::string resume;
+    resume.swap(token);
+    if (prefix.empty() || page_size == 0) return page;
+    if (!resume.empty() && resume.compare(0, prefix.size(), prefix) != 0) return page; // token from another prefix
+
+    std::shared_lock<std::shared_mutex> lock(rw_mutex, std::defer_lock);
+    if (adaptive_mode.load(std::memory_order_relaxed)) lock.lock();
+    if (!root) return page;
+
+    const char* pool = suffix_pool.data();
+    std::size_t tail_matched = 0;
+    const Node* node = findPrefixNode(root, prefix.c_str(), pool, tail_matched);
+    if (!node) return page;
+
+    // ask for one extra word to learn whether there is a next page
+    std::size_t want = page_size + 1;
+    std::string current = prefix;
+    if (resume.empty() && tail_matched == 0 && node->isEnd) page.push_back(prefix);
+    if (node->tail_len) {
+        // a single tail word is all there is below the prefix
+        current.append(tailOf(node, pool).substr(tail_matched));
+        if (resume.empty() || current > resume) page.push_back(current);
+    } else if (resume.size() > prefix.size()) {
+        collectAfter(node->eq, current, resume.c_str() + prefix.size(), page, want, pool);
+    } else {
+        collect(node->eq, current, page, want, pool); // first page, or the token was the prefix itself
+    }
+
+    if (page.size() > page_size) {
+        page.pop_back();
+        token = page.back();
+    }
+    return page;
+}
+
+std::size_t TernarySearchTree::countPrefix(const std::string& prefix) const {
+    std::shared_lock<std::shared_mutex> lock(rw_mutex, std::defer_lock);
+    if (adaptive_mode.load(std::memory_order_relaxed)) lock.lock();
+    return countPrefixUnlocked(prefix);
+}
+
+std::string TernarySearchTree::select(const std::string& prefix, std::size_t index) const {
+    std::shared_lock<std::shared_mutex> lock(rw_mutex, std::defer_lock);
+    if (adaptive_mode.load(std::memory_order_relaxed)) lock.lock();
+    return selectUnlocked(prefix, index);
+}
+
+std::string TernarySearchTree::sample(const std::string& prefix, std::mt19937& rng) const {
+    std::shared_lock<std::shared_mutex> lock(rw_mutex, std::defer_lock);
+    if (adaptive_mode.load(std::memory_order_relaxed)) lock.lock();
+
+    std::size_t total = countPrefixUnlocked(prefix);
+    if (total == 0) return "";
+    std::uniform_int_distribution<std::size_t> pick(0, total - 1);
+    return selectUnlocked(prefix, pick(rng));
+}
+
 std::size_t TernarySearchTree::nodeCount() const { return node_count; }
 
 bool TernarySearchTree::empty() const { return root == nullptr; }
@@ -46,73 +124,452 @@ std::vector<std::string> TernarySearchTree::autoComplete(const std::string& pref
 
 std::size_t TernarySearchTree::getMemoryUsage() const {
     // rough estimate of memory usage
-    return node_count * sizeof(Node);
+    return node_count * sizeof(Node) + suffix_pool.capacity();
+}
+
+std::size_t TernarySearchTree::tailChars() const {
+    std::shared_lock<std::shared_mutex> lock(rw_mutex, std::defer_lock);
+    if (adaptive_mode.load(std::memory_order_relaxed)) lock.lock();
+
+    std::size_t chars = 0;
+    std::vector<const Node*> stack;
+    if (root) stack.push_back(root);
+    while (!stack.empty()) {
+        const Node* node = stack.back();
+        stack.pop_back();
+        chars += node->tail_len;
+        if (node->left) stack.push_back(node->left);
+        if (node->eq) stack.push_back(node->eq);
+        if (node->right) stack.push_back(node->right);
+    }
+    return chars;
+}
+
+std::size_t TernarySearchTree::suffixPoolBytes() const { return suffix_pool.size(); }
+
+void TernarySearchTree::setAdaptive(bool enabled) { adaptive_mode.store(enabled); }
+
+bool TernarySearchTree::adaptive() const { return adaptive_mode.load(); }
+
+void TernarySearchTree::rebalance() {
+    if (!adaptive_mode.load()) return;
+    std::unique_lock<std::shared_mutex> lock(rw_mutex);
+    root = rebalanceLevel(root);
+}
+
+void TernarySearchTree::containsBatch(const std::vector<std::string>& words, std::vector<bool>& out, std::size_t group) const {
+    lookupBatch(words, out, group, true);
+}
+
+void TernarySearchTree::findPrefixBatch(const std::vector<std::string>& prefixes, std::vector<bool>& out, std::size_t group) const {
+    lookupBatch(prefixes, out, group, false);
+}
+
+std::size_t TernarySearchTree::probeDepth(const std::string& word) const {
+    if (word.empty()) return 0;
+    std::shared_lock<std::shared_mutex> lock(rw_mutex, std::defer_lock);
+    if (adaptive_mode.load(std::memory_order_relaxed)) lock.lock();
+
+    std::size_t comparisons = 0;
+    const Node* node = root;
+    const char* w = word.c_str();
+    while (node) {
+        ++comparisons;
+        if (*w < node->ch) {
+            node = node->left;
+        } else if (*w > node->ch) {
+            node = node->right;
+        } else {
+            if (*(w + 1) == '\0') break;
+            if (node->tail_len) {
+                ++comparisons; // one memcmp against the tail
+                break;
+            }
+            node = node->eq;
+            ++w;
+        }
+    }
+    return comparisons;
 }
 
 // static helpers
-TernarySearchTree::Node* TernarySearchTree::insert(Node* node, const char* word, std::size_t& node_count_ref) {
+TernarySearchTree::Node* TernarySearchTree::insert(Node* node, const char* word, std::size_t& node_count_ref, bool& added, std::string& pool) {
     char c = *word;
     if (c == '\0') return node; // shouldn't happen since we guard empty
 
     if (!node) {
         node = new Node(c);
         ++node_count_ref;
+        // nothing below here yet, so the rest of the word becomes this node's tail.
+        // tails that would not fit the 16-bit length or 32-bit offset fall back to an eq chain
+        std::size_t rest_len = std::strlen(word + 1);
+        if (rest_len > 0 && rest_len <= UINT16_MAX && pool.size() + rest_len <= UINT32_MAX) {
+            node->tail_off = static_cast<std::uint32_t>(pool.size());
+            node->tail_len = static_cast<std::uint16_t>(rest_len);
+            pool.append(word + 1, rest_len);
+            added = true;
+#ifdef AUTOCOMPLETE_SUBTREE_COUNTS
+            node->count = 1;
+#endif
+            return node;
+        }
     }
 
     if (c < node->ch) {
-        node->left = insert(node->left, word, node_count_ref);
+        node->left = insert(node->left, word, node_count_ref, added, pool);
     } else if (c > node->ch) {
-        node->right = insert(node->right, word, node_count_ref);
+        node->right = insert(node->right, word, node_count_ref, added, pool);
     } else { // equal char
         if (*(word + 1) == '\0') {
+            added = !node->isEnd;
             node->isEnd = true;
         } else {
-            node->eq = insert(node->eq, word + 1, node_count_ref);
+            if (node->tail_len) {
+                if (tailEquals(node, word + 1, pool.data())) return node; // already there
+                // lazy split: push the tail one level down, the recursion splits further
+                // while the new word keeps following it
+                Node* child = new Node(pool[node->tail_off]);
+                ++node_count_ref;
+                if (node->tail_len > 1) {
+                    child->tail_off = node->tail_off + 1;
+                    child->tail_len = node->tail_len - 1;
+                } else {
+                    child->isEnd = true;
+                }
+#ifdef AUTOCOMPLETE_SUBTREE_COUNTS
+                child->count = 1;
+#endif
+                node->eq = child;
+                node->tail_len = 0;
+            }
+            node->eq = insert(node->eq, word + 1, node_count_ref, added, pool);
         }
     }
+#ifdef AUTOCOMPLETE_SUBTREE_COUNTS
+    if (added) ++node->count; // every node on the path has the new word in its subtree
+#endif
     return node;
 }
 
-bool TernarySearchTree::contains(const Node* node, const char* word) {
+bool TernarySearchTree::contains(const Node* node, const char* word, bool track_hits, const char* pool) {
     if (!node || !word) return false;
     char c = *word;
-    if (c < node->ch) return contains(node->left, word);
-    if (c > node->ch) return contains(node->right, word);
-    // equal
+    if (c < node->ch) return contains(node->left, word, track_hits, pool);
+    if (c > node->ch) return contains(node->right, word, track_hits, pool);
+    // equal, this is the node whose weight we care about when rebalancing
+    if (track_hits) node->hits.fetch_add(1, std::memory_order_relaxed);
     if (*(word + 1) == '\0') return node->isEnd;
-    return contains(node->eq, word + 1);
+    if (node->tail_len) return tailEquals(node, word + 1, pool);
+    return contains(node->eq, word + 1, track_hits, pool);
 }
 
-const TernarySearchTree::Node* TernarySearchTree::findPrefixNode(const Node* node, const char* prefix) {
+bool TernarySearchTree::tailEquals(const Node* node, const char* rest, const char* pool) {
+    return std::strlen(rest) == node->tail_len && std::memcmp(rest, pool + node->tail_off, node->tail_len) == 0;
+}
+
+const TernarySearchTree::Node* TernarySearchTree::findPrefixNode(const Node* node, const char* prefix, const char* pool, std::size_t& tail_matched) {
     if (!node || !prefix) return nullptr;
     char c = *prefix;
-    if (c < node->ch) return findPrefixNode(node->left, prefix);
-    if (c > node->ch) return findPrefixNode(node->right, prefix);
+    if (c < node->ch) return findPrefixNode(node->left, prefix, pool, tail_matched);
+    if (c > node->ch) return findPrefixNode(node->right, prefix, pool, tail_matched);
+    tail_matched = 0;
     if (*(prefix + 1) == '\0') return node; // matched last prefix char at this node
-    return findPrefixNode(node->eq, prefix + 1);
+    if (node->tail_len) {
+        // the rest of the prefix has to be a prefix of the tail
+        std::size_t rest_len = std::strlen(prefix + 1);
+        if (rest_len > node->tail_len || std::memcmp(prefix + 1, pool + node->tail_off, rest_len) != 0) return nullptr;
+        tail_matched = rest_len;
+        return node;
+    }
+    return findPrefixNode(node->eq, prefix + 1, pool, tail_matched);
 }
 
-void TernarySearchTree::collect(const Node* node, std::string& current, std::vector<std::string>& out, std::size_t max_results) {
+void TernarySearchTree::collect(const Node* node, std::string& current, std::vector<std::string>& out, std::size_t max_results, const char* pool) {
     if (!node || out.size() >= max_results) return;
 
     // go left
-    collect(node->left, current, out, max_results);
+    collect(node->left, current, out, max_results, pool);
     if (out.size() >= max_results) return;
 
-    // visit: append char, walk equal, then pop
+    // visit: append char, walk equal (or emit the tail word), then pop
     current.push_back(node->ch);
     if (node->isEnd) {
         out.push_back(current);
     }
     if (out.size() < max_results) {
-        collect(node->eq, current, out, max_results);
+        collectBelow(node, current, out, max_results, pool);
     }
     current.pop_back();
 
     if (out.size() >= max_results) return;
 
     // go right
-    collect(node->right, current, out, max_results);
+    collect(node->right, current, out, max_results, pool);
+}
+
+void TernarySearchTree::collectBelow(const Node* node, std::string& current, std::vector<std::string>& out, std::size_t max_results, const char* pool) {
+    // words that continue past node (current already ends with node->ch)
+    if (out.size() >= max_results) return;
+    if (node->tail_len) {
+        out.push_back(current);
+        out.back().append(tailOf(node, pool));
+        return;
+    }
+    collect(node->eq, current, out, max_results, pool);
+}
+
+std::size_t TernarySearchTree::countPrefixUnlocked(const std::string& prefix) const {
+    if (!root) return 0;
+    if (prefix.empty()) {
+        // every word, like Trie and Dawg
+#ifdef AUTOCOMPLETE_SUBTREE_COUNTS
+        return subtreeCount(root);
+#else
+        std::vector<std::string> all;
+        std::string current;
+        collect(root, current, all, SIZE_MAX, suffix_pool.data());
+        return all.size();
+#endif
+    }
+    std::size_t tail_matched = 0;
+    const Node* node = findPrefixNode(root, prefix.c_str(), suffix_pool.data(), tail_matched);
+    if (!node) return 0;
+    if (tail_matched > 0) return 1;
+#ifdef AUTOCOMPLETE_SUBTREE_COUNTS
+    return ownCount(node);
+#else
+    std::vector<std::string> all;
+    std::string current = prefix;
+    if (node->isEnd) all.push_back(prefix);
+    collectBelow(node, current, all, SIZE_MAX, suffix_pool.data());
+    return all.size();
+#endif
+}
+
+std::string TernarySearchTree::selectUnlocked(const std::string& prefix, std::size_t index) const {
+    if (!root) return "";
+    const char* pool = suffix_pool.data();
+    std::string current = prefix;
+    const Node* level = root; // sibling bst holding the completions, all words for ""
+
+    if (!prefix.empty()) {
+        std::size_t tail_matched = 0;
+        const Node* node = findPrefixNode(root, prefix.c_str(), pool, tail_matched);
+        if (!node) return "";
+
+        if (tail_matched > 0) {
+            if (index > 0) return "";
+            current.append(tailOf(node, pool).substr(tail_matched));
+            return current;
+        }
+        if (node->isEnd) {
+            if (index == 0) return prefix;
+            --index;
+        }
+        if (node->tail_len) {
+            if (index > 0) return "";
+            current.append(tailOf(node, pool));
+            return current;
+        }
+        level = node->eq;
+    }
+#ifdef AUTOCOMPLETE_SUBTREE_COUNTS
+    // in-order within a sibling bst is left subtree, this node (its own word, then
+    // its eq subtree), right subtree; the counts say which part holds the index
+    const Node* at = level;
+    while (at) {
+        std::uint32_t left_words = subtreeCount(at->left);
+        if (index < left_words) {
+            at = at->left;
+            continue;
+        }
+        index -= left_words;
+
+        std::uint32_t own_words = ownCount(at);
+        if (index < own_words) {
+            current.push_back(at->ch);
+            if (at->isEnd) {
+                if (index == 0) return current;
+                --index;
+            }
+            if (at->tail_len) return current.append(tailOf(at, pool)); // index is 0 here
+            at = at->eq;
+            continue;
+        }
+        index -= own_words;
+        at = at->right;
+    }
+    return "";
+#else
+    std::vector<std::string> firsts;
+    collect(level, current, firsts, index + 1, pool);
+    return index < firsts.size() ? firsts[index] : "";
+#endif
+}
+
+void TernarySearchTree::lookupBatch(const std::vector<std::string>& keys, std::vector<bool>& out, std::size_t group, bool whole) const {
+    out.assign(keys.size(), false);
+    if (group == 0) group = 1;
+
+    std::shared_lock<std::shared_mutex> lock(rw_mutex, std::defer_lock);
+    bool track_hits = adaptive_mode.load(std::memory_order_relaxed);
+    if (track_hits) lock.lock();
+    if (!root) return;
+    const char* pool = suffix_pool.data();
+
+    // one lane per in-flight key; a finished lane picks up the next key
+    struct Lane {
+        const Node* node;
+        const char* pos; // nullptr when idle
+        std::size_t key;
+    };
+    std::vector<Lane> lanes(group, Lane{nullptr, nullptr, 0});
+    std::size_t next = 0;
+    auto refill = [&](Lane& lane) {
+        while (next < keys.size() && keys[next].empty()) ++next; // empty keys stay false
+        if (next == keys.size()) {
+            lane.pos = nullptr;
+            return false;
+        }
+        lane.node = root;
+        lane.pos = keys[next].c_str();
+        lane.key = next++;
+        return true;
+    };
+
+    std::size_t busy = 0;
+    for (auto& lane : lanes) {
+        if (refill(lane)) ++busy;
+    }
+
+    while (busy > 0) {
+        for (auto& lane : lanes) {
+            if (!lane.pos) continue;
+
+            const Node* node = lane.node;
+            char c = *lane.pos;
+            const Node* next_node;
+            if (c < node->ch) {
+                next_node = node->left;
+            } else if (c > node->ch) {
+                next_node = node->right;
+            } else {
+                if (track_hits) node->hits.fetch_add(1, std::memory_order_relaxed);
+                const char* rest = lane.pos + 1;
+                if (*rest == '\0') {
+                    out[lane.key] = whole ? node->isEnd : true;
+                    next_node = nullptr;
+                } else if (node->tail_len) {
+                    std::size_t rest_len = std::strlen(rest);
+                    out[lane.key] = (whole ? rest_len == node->tail_len : rest_len <= node->tail_len) &&
+                                    std::memcmp(rest, pool + node->tail_off, rest_len) == 0;
+                    next_node = nullptr;
+                } else {
+                    next_node = node->eq;
+                    ++lane.pos;
+                }
+            }
+
+            if (next_node) {
+                __builtin_prefetch(next_node);
+                lane.node = next_node;
+            } else if (!refill(lane)) {
+                --busy;
+            }
+        }
+    }
+}
+
+void TernarySearchTree::collectAfter(const Node* node, std::string& current, const char* rest, std::vector<std::string>& out, std::size_t max_results, const char* pool) {
+    // emit the words under node that sort after current + rest, without visiting earlier ones
+    if (!node || out.size() >= max_results) return;
+    char c = *rest;
+
+    if (c > node->ch) {
+        // this node and its left side are all before the token
+        collectAfter(node->right, current, rest, out, max_results, pool);
+        return;
+    }
+
+    if (c < node->ch) {
+        // token is on the left; this node and its right side all come after it
+        collectAfter(node->left, current, rest, out, max_results, pool);
+        if (out.size() >= max_results) return;
+        current.push_back(node->ch);
+        if (node->isEnd) out.push_back(current);
+        collectBelow(node, current, out, max_results, pool);
+        current.pop_back();
+    } else {
+        // on the token's path: the word ending here is a prefix of the token (or the token)
+        current.push_back(node->ch);
+        if (*(rest + 1) == '\0') {
+            collectBelow(node, current, out, max_results, pool);
+        } else if (node->tail_len) {
+            if (tailOf(node, pool) > std::string_view(rest + 1)) collectBelow(node, current, out, max_results, pool);
+        } else {
+            collectAfter(node->eq, current, rest + 1, out, max_results, pool);
+        }
+        current.pop_back();
+    }
+
+    if (out.size() >= max_results) return;
+    collect(node->right, current, out, max_results, pool);
+}
+
+TernarySearchTree::Node* TernarySearchTree::rebalanceLevel(Node* level_root) {
+    if (!level_root) return nullptr;
+
+    // flatten this level's sibling bst in order, fixing up the levels below on the way
+    std::vector<Node*> siblings;
+    std::vector<Node*> stack;
+    Node* cur = level_root;
+    while (cur || !stack.empty()) {
+        while (cur) {
+            stack.push_back(cur);
+            cur = cur->left;
+        }
+        cur = stack.back();
+        stack.pop_back();
+        siblings.push_back(cur);
+        cur = cur->right;
+    }
+
+    std::vector<std::uint64_t> weight_sums(siblings.size() + 1, 0);
+    for (std::size_t i = 0; i < siblings.size(); ++i) {
+        Node* node = siblings[i];
+        node->eq = rebalanceLevel(node->eq);
+        // +1 keeps never-queried siblings balanced among themselves
+        weight_sums[i + 1] = weight_sums[i] + node->hits.load(std::memory_order_relaxed) + 1;
+        // halve so the shape follows shifts in the query distribution
+        node->hits.store(node->hits.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+    }
+    return buildWeighted(siblings, weight_sums, 0, siblings.size());
+}
+
+TernarySearchTree::Node* TernarySearchTree::buildWeighted(std::vector<Node*>& siblings, const std::vector<std::uint64_t>& weight_sums, std::size_t lo, std::size_t hi) {
+    if (lo >= hi) return nullptr;
+
+    // pick the root that best splits the hit weight between its two sides
+    std::size_t best = lo;
+    std::uint64_t best_gap = UINT64_MAX;
+    for (std::size_t k = lo; k < hi; ++k) {
+        std::uint64_t left_weight = weight_sums[k] - weight_sums[lo];
+        std::uint64_t right_weight = weight_sums[hi] - weight_sums[k + 1];
+        std::uint64_t gap = left_weight > right_weight ? left_weight - right_weight : right_weight - left_weight;
+        if (gap < best_gap) {
+            best_gap = gap;
+            best = k;
+        }
+    }
+
+    Node* node = siblings[best];
+    node->left = buildWeighted(siblings, weight_sums, lo, best);
+    node->right = buildWeighted(siblings, weight_sums, best + 1, hi);
+#ifdef AUTOCOMPLETE_SUBTREE_COUNTS
+    // the sibling bst changed shape, the eq subtree did not
+    node->count = subtreeCount(node->left) + subtreeCount(node->right) + ownCount(node);
+#endif
+    return node;
 }
 
 void TernarySearchTree::destroy(Node* node) {